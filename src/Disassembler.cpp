@@ -23,10 +23,17 @@
 
 #include "Disassembler.h"
 
-#include <boost/uuid/uuid_generators.hpp>
+#include <algorithm>
+#include <array>
+#include <variant>
 
 #include "AuxDataSchema.h"
+#include "ModuleIndex.h"
+#include "SymbolResolver.h"
+#include "UUIDGenerator.h"
 #include "gtirb-decoder/CompositeLoader.h"
+#include "gtirb-decoder/Parallel.h"
+#include "gtirb-decoder/Stats.h"
 
 using ImmOp = relations::ImmOp;
 using IndirectOp = relations::IndirectOp;
@@ -63,55 +70,93 @@ struct DecodedInstruction
 {
     gtirb::Addr EA;
     uint64_t Size;
-    std::map<uint64_t, std::variant<ImmOp, IndirectOp>> Operands;
+    // Operand codes of the operands 1 to 4, or 0 for missing operands.
+    std::array<uint64_t, 4> Operands;
     int64_t immediateOffset;
     int64_t displacementOffset;
 };
 
-std::map<gtirb::Addr, DecodedInstruction> recoverInstructions(souffle::SouffleProgram *prog)
+// Instructions of the final code, sorted by address. Operand payloads are
+// kept in flat arrays indexed by operand code.
+struct DecodedInstructions
 {
-    std::map<uint64_t, ImmOp> Immediates;
+    enum class OperandKind : uint8_t
+    {
+        None,
+        Immediate,
+        Indirect
+    };
+
+    const DecodedInstruction *find(gtirb::Addr EA) const
+    {
+        auto It = std::lower_bound(
+            Instructions.begin(), Instructions.end(), EA,
+            [](const DecodedInstruction &Insn, const gtirb::Addr &A) { return Insn.EA < A; });
+        return It != Instructions.end() && It->EA == EA ? &*It : nullptr;
+    }
+
+    OperandKind kind(uint64_t Code) const
+    {
+        return Code < Kinds.size() ? Kinds[Code] : OperandKind::None;
+    }
+
+    void add(uint64_t Code, OperandKind Kind, ImmOp Immediate = 0)
+    {
+        if(Code >= Kinds.size())
+        {
+            Kinds.resize(Code + 1, OperandKind::None);
+            Immediates.resize(Code + 1, 0);
+        }
+        Kinds[Code] = Kind;
+        Immediates[Code] = Immediate;
+    }
+
+    std::vector<DecodedInstruction> Instructions;
+    std::vector<OperandKind> Kinds;
+    std::vector<ImmOp> Immediates;
+};
+
+// Recover the instructions at the sorted addresses `CodeAddresses', leaving
+// out the candidates of the instruction superset that are not code.
+DecodedInstructions recoverInstructions(souffle::SouffleProgram *prog,
+                                        const std::vector<gtirb::Addr> &CodeAddresses)
+{
+    DecodedInstructions Decoded;
     for(auto &output : *prog->getRelation("op_immediate"))
     {
         uint64_t operandCode;
         ImmOp immediate;
         output >> operandCode >> immediate;
-        Immediates[operandCode] = immediate;
+        Decoded.add(operandCode, DecodedInstructions::OperandKind::Immediate, immediate);
     };
-    std::map<uint64_t, IndirectOp> Indirects;
     for(auto &output : *prog->getRelation("op_indirect"))
     {
-        uint64_t operandCode, size;
-        IndirectOp indirect;
-        output >> operandCode >> indirect.Reg1 >> indirect.Reg2 >> indirect.Reg3 >> indirect.Mult
-            >> indirect.Disp >> size;
-        Indirects[operandCode] = indirect;
+        uint64_t operandCode;
+        output >> operandCode;
+        Decoded.add(operandCode, DecodedInstructions::OperandKind::Indirect);
     };
-    std::map<gtirb::Addr, DecodedInstruction> insns;
+    Decoded.Instructions.reserve(CodeAddresses.size());
     for(auto &output : *prog->getRelation("instruction_complete"))
     {
-        DecodedInstruction insn;
         gtirb::Addr EA;
+        output >> EA;
+        if(!std::binary_search(CodeAddresses.begin(), CodeAddresses.end(), EA))
+        {
+            continue;
+        }
+        DecodedInstruction &insn = Decoded.Instructions.emplace_back();
         std::string prefix, opcode;
-        output >> EA >> insn.Size >> prefix >> opcode;
-        for(size_t i = 1; i <= 4; i++)
+        insn.EA = EA;
+        output >> insn.Size >> prefix >> opcode;
+        for(uint64_t &operandCode : insn.Operands)
         {
-            uint64_t operandIndex;
-            output >> operandIndex;
-            auto foundImmediate = Immediates.find(operandIndex);
-            if(foundImmediate != Immediates.end())
-                insn.Operands[i] = foundImmediate->second;
-            else
-            {
-                auto foundIndirect = Indirects.find(operandIndex);
-                if(foundIndirect != Indirects.end())
-                    insn.Operands[i] = foundIndirect->second;
-            }
+            output >> operandCode;
         }
         output >> insn.immediateOffset >> insn.displacementOffset;
-        insns[EA] = insn;
     }
-    return insns;
+    std::sort(Decoded.Instructions.begin(), Decoded.Instructions.end(),
+              [](const DecodedInstruction &A, const DecodedInstruction &B) { return A.EA < B.EA; });
+    return Decoded;
 }
 
 struct CodeInBlock
@@ -221,10 +266,101 @@ struct BlockPoints
     std::string Why;
 };
 
+// Facts of a relation sorted by address in a contiguous array. Facts with the
+// same address keep the order of the relation.
 template <typename T>
-using VectorByEA = boost::multi_index_container<
-    T, boost::multi_index::indexed_by<boost::multi_index::ordered_non_unique<
-           boost::multi_index::member<T, decltype(T::EA), &T::EA>>>>;
+class VectorByEA
+{
+public:
+    using value_type = T;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    VectorByEA() = default;
+
+    explicit VectorByEA(std::vector<T> &&Facts) : Elements(std::move(Facts))
+    {
+        // Souffle iterates most relations in this order already.
+        if(!std::is_sorted(Elements.begin(), Elements.end(), compare))
+        {
+            std::stable_sort(Elements.begin(), Elements.end(), compare);
+        }
+    }
+
+    const_iterator begin() const
+    {
+        return Elements.begin();
+    }
+
+    const_iterator end() const
+    {
+        return Elements.end();
+    }
+
+    size_t size() const
+    {
+        return Elements.size();
+    }
+
+    const_iterator lower_bound(gtirb::Addr EA) const
+    {
+        return std::lower_bound(
+            Elements.begin(), Elements.end(), EA,
+            [](const T &Element, const gtirb::Addr &A) { return Element.EA < A; });
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(gtirb::Addr EA) const
+    {
+        const_iterator It = lower_bound(EA);
+        const_iterator End = It;
+        while(End != Elements.end() && End->EA == EA)
+        {
+            ++End;
+        }
+        return {It, End};
+    }
+
+    // First fact at the address EA, or end().
+    const_iterator find(gtirb::Addr EA) const
+    {
+        const_iterator It = lower_bound(EA);
+        return It != Elements.end() && It->EA == EA ? It : Elements.end();
+    }
+
+private:
+    static bool compare(const T &A, const T &B)
+    {
+        return A.EA < B.EA;
+    }
+
+    std::vector<T> Elements;
+};
+
+// Cursor over the facts of a VectorByEA for addresses that are visited in
+// increasing order.
+template <typename T>
+class CursorByEA
+{
+public:
+    CursorByEA(const VectorByEA<T> &Facts, gtirb::Addr EA)
+        : It(Facts.lower_bound(EA)), End(Facts.end())
+    {
+    }
+
+    // First fact at the address EA, which must not be lower than the address
+    // of the previous call.
+    const T *at(gtirb::Addr EA)
+    {
+        while(It != End && It->EA < EA)
+        {
+            ++It;
+        }
+        return It != End && It->EA == EA ? &*It : nullptr;
+    }
+
+private:
+    typename VectorByEA<T>::const_iterator It;
+    typename VectorByEA<T>::const_iterator End;
+};
 
 struct SymbolicData
 {
@@ -342,13 +478,23 @@ template <typename T>
 std::vector<T> convertRelation(const std::string &relation, souffle::SouffleProgram *prog)
 {
     std::vector<T> result;
-    for(auto &output : *prog->getRelation(relation))
+    souffle::Relation *rel = prog->getRelation(relation);
+    result.reserve(rel->size());
+    for(auto &output : *rel)
     {
         result.emplace_back(output);
     }
     return result;
 }
 
+// Read a relation whose first attribute is an address into a flat array
+// sorted by that address.
+template <typename T>
+VectorByEA<T> convertRelationByEA(const std::string &relation, souffle::SouffleProgram *prog)
+{
+    return VectorByEA<T>(convertRelation<T>(relation, prog));
+}
+
 template <typename Container, typename Elem = typename Container::value_type>
 Container convertSortedRelation(const std::string &relation, souffle::SouffleProgram *prog)
 {
@@ -373,14 +519,7 @@ std::set<gtirb::Addr> convertSortedRelation<std::set<gtirb::Addr>>(const std::st
     return result;
 }
 
-static std::string getLabel(uint64_t ea)
-{
-    std::stringstream ss;
-    ss << ".L_" << std::hex << ea;
-    return ss.str();
-}
-
-void buildInferredSymbols(gtirb::Context &context, gtirb::Module &module,
+void buildInferredSymbols(gtirb::Context &context, gtirb::Module &module, ModuleIndex &index,
                           souffle::SouffleProgram *prog)
 {
     auto *SymbolInfo = module.getAuxData<gtirb::schema::ElfSymbolInfoAD>();
@@ -392,7 +531,7 @@ void buildInferredSymbols(gtirb::Context &context, gtirb::Module &module,
         output >> addr >> name >> scope;
         if(!module.findSymbols(name))
         {
-            gtirb::Symbol *symbol = module.addSymbol(context, addr, name);
+            gtirb::Symbol *symbol = index.addSymbol(context, addr, name);
             if(SymbolInfo)
             {
                 ElfSymbolInfo Info = {0, "NONE", scope, "DEFAULT", 0};
@@ -420,20 +559,20 @@ void buildInferredSymbols(gtirb::Context &context, gtirb::Module &module,
 }
 
 // auxiliary function to get a symbol with an address and name
-gtirb::Symbol *findSymbol(gtirb::Module &module, gtirb::Addr ea, std::string name)
+gtirb::Symbol *findSymbol(const ModuleIndex &index, gtirb::Addr ea, std::string name)
 {
-    auto found = module.findSymbols(ea);
-    for(gtirb::Symbol &symbol : found)
+    auto [begin, end] = index.symbols(ea);
+    for(auto it = begin; it != end; it++)
     {
-        if(symbol.getName() == name)
-            return &symbol;
+        if(it->second->getName() == name)
+            return it->second;
     }
     return nullptr;
 }
 
 // Build a first version of the SymbolForwarding table with copy relocations
 void buildSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
-                           souffle::SouffleProgram *prog)
+                           const ModuleIndex &index, souffle::SouffleProgram *prog)
 {
     std::map<gtirb::UUID, gtirb::UUID> symbolForwarding;
     for(auto &output : *prog->getRelation("relocation"))
@@ -444,7 +583,7 @@ void buildSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
         output >> ea >> type >> name >> offset;
         if(type == "COPY")
         {
-            gtirb::Symbol *copySymbol = findSymbol(module, ea, name);
+            gtirb::Symbol *copySymbol = findSymbol(index, ea, name);
             if(copySymbol)
             {
                 gtirb::Symbol *realSymbol = module.addSymbol(context, name);
@@ -477,39 +616,10 @@ bool isNullReg(const std::string &reg)
     return reg == "NONE";
 }
 
-gtirb::Symbol *getSymbol(gtirb::Context &context, gtirb::Module &module, gtirb::Addr ea)
-{
-    const auto *symbolForwarding = module.getAuxData<gtirb::schema::SymbolForwarding>();
-    auto found = module.findSymbols(ea);
-    if(!found.empty())
-    {
-        gtirb::Symbol *bestSymbol = &*found.begin();
-        for(auto it = found.begin(); it != found.end(); it++)
-        {
-            auto forwardSymbol = symbolForwarding->find(it->getUUID());
-            if(forwardSymbol != symbolForwarding->end())
-                bestSymbol = &*it;
-        }
-        return bestSymbol;
-    }
-
-    gtirb::Symbol *symbol = module.addSymbol(context, ea, getLabel(uint64_t(ea)));
-
-    auto *SymbolInfo = module.getAuxData<gtirb::schema::ElfSymbolInfoAD>();
-    if(SymbolInfo)
-    {
-        ElfSymbolInfo Info = {0, "NONE", "LOCAL", "DEFAULT", 0};
-        SymbolInfo->insert({symbol->getUUID(), Info});
-    }
-
-    return symbol;
-}
-
 // Expand the SymbolForwarding table with plt references
-void expandSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
-                            souffle::SouffleProgram *prog)
+void expandSymbolForwarding(gtirb::Module &module, const ModuleIndex &index,
+                            SymbolResolver &symbols, souffle::SouffleProgram *prog)
 {
-    auto *symbolForwarding = module.getAuxData<gtirb::schema::SymbolForwarding>();
     for(auto &output : *prog->getRelation("plt_block"))
     {
         gtirb::Addr ea;
@@ -517,13 +627,13 @@ void expandSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
         output >> ea >> name;
         // the inference of plt_block guarantees that there is at most one
         // destination symbol for each source
-        auto foundSrc = module.findSymbols(ea);
+        auto [srcBegin, srcEnd] = index.symbols(ea);
         auto foundDest = module.findSymbols(name);
-        for(gtirb::Symbol &src : foundSrc)
+        for(auto src = srcBegin; src != srcEnd; src++)
         {
             for(gtirb::Symbol &dest : foundDest)
             {
-                (*symbolForwarding)[src.getUUID()] = dest.getUUID();
+                symbols.forward(*src->second, dest);
             }
         }
     }
@@ -532,13 +642,13 @@ void expandSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
         gtirb::Addr ea;
         std::string name;
         output >> ea >> name;
-        auto foundSrc = module.findSymbols(ea);
+        auto [srcBegin, srcEnd] = index.symbols(ea);
         auto foundDest = module.findSymbols(name);
-        for(gtirb::Symbol &src : foundSrc)
+        for(auto src = srcBegin; src != srcEnd; src++)
         {
             for(gtirb::Symbol &dest : foundDest)
             {
-                (*symbolForwarding)[src.getUUID()] = dest.getUUID();
+                symbols.forward(*src->second, dest);
             }
         }
     }
@@ -548,23 +658,22 @@ void expandSymbolForwarding(gtirb::Context &context, gtirb::Module &module,
         gtirb::Addr ea, dest;
 
         output >> ea >> dest;
-        auto foundSrc = module.findSymbols(ea);
-        gtirb::Symbol *destSymbol = getSymbol(context, module, dest);
-        for(gtirb::Symbol &src : foundSrc)
+        auto [srcBegin, srcEnd] = index.symbols(ea);
+        gtirb::Symbol *destSymbol = symbols.get(dest);
+        for(auto src = srcBegin; src != srcEnd; src++)
         {
-            (*symbolForwarding)[src.getUUID()] = destSymbol->getUUID();
+            symbols.forward(*src->second, *destSymbol);
         }
     }
 }
 
 template <class ExprType, typename... Args>
-void addSymbolicExpressionToCodeBlock(gtirb::Module &Module, gtirb::Addr Addr, uint64_t Size,
-                                      uint64_t Offset, Args... A)
+void addSymbolicExpressionToCodeBlock(gtirb::Module &Module, const ModuleIndex &Index,
+                                      gtirb::Addr Addr, uint64_t Size, uint64_t Offset, Args... A)
 {
-    if(auto it = Module.findCodeBlocksOn(Addr); !it.empty())
+    if(gtirb::CodeBlock *Block = Index.codeBlockOn(Addr))
     {
-        gtirb::CodeBlock &Block = *it.begin();
-        gtirb::ByteInterval *ByteInterval = Block.getByteInterval();
+        gtirb::ByteInterval *ByteInterval = Block->getByteInterval();
         std::optional<gtirb::Addr> BaseAddr = ByteInterval->getAddress();
         assert(BaseAddr && "Found byte interval without address.");
         uint64_t BlockOffset = static_cast<uint64_t>(Addr - *BaseAddr + Offset);
@@ -577,9 +686,23 @@ void addSymbolicExpressionToCodeBlock(gtirb::Module &Module, gtirb::Addr Addr, u
     }
 }
 
-void buildSymbolicImmediate(gtirb::Context &context, gtirb::Module &module, const gtirb::Addr &ea,
-                            const DecodedInstruction &instruction, uint64_t index, ImmOp &immediate,
-                            const SymbolicInfo &symbolicInfo)
+// Symbolic expression of an instruction operand. Expressions are planned
+// concurrently and added to the module afterwards, in address order.
+struct CodeExpression
+{
+    gtirb::Addr EA;
+    uint64_t Size;
+    uint64_t Offset;
+    int64_t Addend;
+    // Symbol of a relocation; otherwise the symbol is resolved at Target.
+    gtirb::Symbol *Symbol;
+    gtirb::Addr Target;
+};
+
+void planSymbolicImmediate(gtirb::Module &module, const gtirb::Addr &ea,
+                           const DecodedInstruction &instruction, uint64_t operandIndex,
+                           const ImmOp &immediate, const SymbolicInfo &symbolicInfo,
+                           std::vector<CodeExpression> &expressions)
 {
     // Symbolic expression from relocation
     if(const auto symbolicExpr =
@@ -590,9 +713,9 @@ void buildSymbolicImmediate(gtirb::Context &context, gtirb::Module &module, cons
         if(foundSymbol.begin() != foundSymbol.end())
         {
             // FIXME: We need to handle overlapping sections here.
-            addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-                module, ea, symbolicExpr->Size, instruction.immediateOffset, symbolicExpr->Addend,
-                &*foundSymbol.begin());
+            expressions.push_back({ea, symbolicExpr->Size,
+                                   static_cast<uint64_t>(instruction.immediateOffset),
+                                   symbolicExpr->Addend, &*foundSymbol.begin(), gtirb::Addr(0)});
             return;
         }
     }
@@ -600,35 +723,38 @@ void buildSymbolicImmediate(gtirb::Context &context, gtirb::Module &module, cons
     auto rangeMovedLabel = symbolicInfo.MovedLabels.equal_range(ea);
     if(auto movedLabel =
            std::find_if(rangeMovedLabel.first, rangeMovedLabel.second,
-                        [index](const auto &element) { return element.OperandIndex == index; });
+                        [operandIndex](const auto &element) {
+                            return element.OperandIndex == operandIndex;
+                        });
        movedLabel != rangeMovedLabel.second)
     {
         assert(movedLabel->Address1 == immediate);
         auto diff = movedLabel->Address1 - movedLabel->Address2;
-        auto sym = getSymbol(context, module, gtirb::Addr(movedLabel->Address2));
-        addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-            module, ea, instruction.Size - instruction.immediateOffset, instruction.immediateOffset,
-            diff, sym);
+        expressions.push_back({ea, instruction.Size - instruction.immediateOffset,
+                               static_cast<uint64_t>(instruction.immediateOffset), diff,
+                               nullptr, gtirb::Addr(movedLabel->Address2)});
         return;
     }
     // Symbol+0 case
     auto range = symbolicInfo.SymbolicExpressionNoOffsets.equal_range(ea);
     if(auto symOp =
            std::find_if(range.first, range.second,
-                        [index](const auto &element) { return element.OperandIndex == index; });
+                        [operandIndex](const auto &element) {
+                            return element.OperandIndex == operandIndex;
+                        });
        symOp != range.second)
     {
-        auto sym = getSymbol(context, module, gtirb::Addr(symOp->Dest));
-        addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-            module, ea, instruction.Size - instruction.immediateOffset, instruction.immediateOffset,
-            0, sym);
+        expressions.push_back({ea, instruction.Size - instruction.immediateOffset,
+                               static_cast<uint64_t>(instruction.immediateOffset), 0, nullptr,
+                               gtirb::Addr(symOp->Dest)});
         return;
     }
 }
 
-void buildSymbolicIndirect(gtirb::Context &context, gtirb::Module &module, const gtirb::Addr &ea,
-                           const DecodedInstruction &instruction, uint64_t index,
-                           const SymbolicInfo &symbolicInfo)
+void planSymbolicIndirect(gtirb::Module &module, const gtirb::Addr &ea,
+                          const DecodedInstruction &instruction, uint64_t operandIndex,
+                          const SymbolicInfo &symbolicInfo,
+                          std::vector<CodeExpression> &expressions)
 {
     uint64_t DispSize = 0;
     if(instruction.displacementOffset > 0)
@@ -638,6 +764,7 @@ void buildSymbolicIndirect(gtirb::Context &context, gtirb::Module &module, const
         uint64_t Disp = instruction.displacementOffset;
         DispSize = Imm > Disp ? Imm - Disp : Size - Disp;
     }
+    uint64_t dispOffset = static_cast<uint64_t>(instruction.displacementOffset);
 
     // Symbolic expression form relocation
     if(const auto symbolicExpr = symbolicInfo.SymbolicExpressionsFromRelocations.find(
@@ -647,9 +774,8 @@ void buildSymbolicIndirect(gtirb::Context &context, gtirb::Module &module, const
         auto foundSymbol = module.findSymbols(symbolicExpr->Symbol);
         if(foundSymbol.begin() != foundSymbol.end())
         {
-            addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-                module, ea, symbolicExpr->Size, instruction.displacementOffset,
-                symbolicExpr->Addend, &*foundSymbol.begin());
+            expressions.push_back({ea, symbolicExpr->Size, dispOffset, symbolicExpr->Addend,
+                                   &*foundSymbol.begin(), gtirb::Addr(0)});
             return;
         }
     }
@@ -657,89 +783,138 @@ void buildSymbolicIndirect(gtirb::Context &context, gtirb::Module &module, const
     auto rangeMovedLabel = symbolicInfo.MovedLabels.equal_range(ea);
     if(auto movedLabel =
            std::find_if(rangeMovedLabel.first, rangeMovedLabel.second,
-                        [index](const auto &element) { return element.OperandIndex == index; });
+                        [operandIndex](const auto &element) {
+                            return element.OperandIndex == operandIndex;
+                        });
        movedLabel != rangeMovedLabel.second)
     {
         auto diff = movedLabel->Address1 - movedLabel->Address2;
-        auto sym = getSymbol(context, module, gtirb::Addr(movedLabel->Address2));
-        addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-            module, ea, DispSize, instruction.displacementOffset, diff, sym);
+        expressions.push_back(
+            {ea, DispSize, dispOffset, diff, nullptr, gtirb::Addr(movedLabel->Address2)});
         return;
     }
     // Symbol+0 case
     auto range = symbolicInfo.SymbolicExpressionNoOffsets.equal_range(ea);
     for(auto it = range.first; it != range.second; it++)
     {
-        if(it->OperandIndex == index)
+        if(it->OperandIndex == operandIndex)
         {
-            auto sym = getSymbol(context, module, gtirb::Addr(it->Dest));
-            addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
-                module, ea, DispSize, instruction.displacementOffset, 0, sym);
+            expressions.push_back({ea, DispSize, dispOffset, 0, nullptr, gtirb::Addr(it->Dest)});
         }
     }
 }
 
-void buildCodeSymbolicInformation(gtirb::Context &context, gtirb::Module &module,
-                                  souffle::SouffleProgram *prog)
+// Instructions per chunk of buildCodeSymbolicInformation.
+constexpr size_t CodeChunkSize = 4096;
+
+void buildCodeSymbolicInformation(gtirb::Module &module, const ModuleIndex &index,
+                                  SymbolResolver &symbols, souffle::SouffleProgram *prog,
+                                  unsigned int threads)
 {
     auto codeInBlock = convertRelation<CodeInBlock>("code_in_refined_block", prog);
     SymbolicInfo symbolicInfo{
-        convertSortedRelation<VectorByEA<MovedLabel>>("moved_label", prog),
-        convertSortedRelation<VectorByEA<SymbolicExpressionNoOffset>>("symbolic_operand", prog),
-        convertSortedRelation<VectorByEA<SymbolicExpr>>("symbolic_expr_from_relocation", prog)};
-    auto splitLoad = convertSortedRelation<VectorByEA<SplitLoad>>("split_load", prog);
-    std::map<gtirb::Addr, DecodedInstruction> decodedInstructions = recoverInstructions(prog);
-
+        convertRelationByEA<MovedLabel>("moved_label", prog),
+        convertRelationByEA<SymbolicExpressionNoOffset>("symbolic_operand", prog),
+        convertRelationByEA<SymbolicExpr>("symbolic_expr_from_relocation", prog)};
+    auto splitLoad = convertRelationByEA<SplitLoad>("split_load", prog);
+    std::vector<gtirb::Addr> codeAddresses;
+    codeAddresses.reserve(codeInBlock.size());
     for(auto &cib : codeInBlock)
     {
-        const auto inst = decodedInstructions.find(cib.EA);
-        assert(inst != decodedInstructions.end());
-        for(auto &op : inst->second.Operands)
+        codeAddresses.push_back(cib.EA);
+    }
+    std::sort(codeAddresses.begin(), codeAddresses.end());
+    DecodedInstructions decodedInstructions = recoverInstructions(prog, codeAddresses);
+    const std::vector<DecodedInstruction> &instructions = decodedInstructions.Instructions;
+
+    // Split the instructions into chunks that do not cross byte intervals.
+    std::vector<size_t> chunkBegins;
+    const gtirb::ByteInterval *interval = nullptr;
+    for(size_t i = 0; i < instructions.size(); i++)
+    {
+        gtirb::Addr ea = instructions[i].EA;
+        bool inInterval = interval && ea >= *interval->getAddress()
+                          && ea < *interval->getAddress() + interval->getSize();
+        if(!inInterval || i - chunkBegins.back() >= CodeChunkSize)
         {
-            if(auto *immediate = std::get_if<ImmOp>(&op.second))
-                buildSymbolicImmediate(context, module, inst->first, inst->second, op.first,
-                                       *immediate, symbolicInfo);
-            if(std::get_if<IndirectOp>(&op.second))
-                buildSymbolicIndirect(context, module, inst->first, inst->second, op.first,
-                                      symbolicInfo);
+            if(!inInterval)
+            {
+                interval = index.byteIntervalOn(ea);
+            }
+            chunkBegins.push_back(i);
         }
-        for(auto &Load : splitLoad)
+    }
+    chunkBegins.push_back(instructions.size());
+
+    // Plan the symbolic expressions of each chunk concurrently: this only
+    // reads the module and the relations.
+    std::vector<std::vector<CodeExpression>> chunks(chunkBegins.size() - 1);
+    parallelFor(chunks.size(), threads, [&](size_t chunk) {
+        std::vector<CodeExpression> &expressions = chunks[chunk];
+        for(size_t i = chunkBegins[chunk]; i < chunkBegins[chunk + 1]; i++)
         {
-            ImmOp dest = Load.Dest;
-            if(Load.EA == inst->first)
+            const DecodedInstruction *inst = &instructions[i];
+            for(uint64_t j = 1; j <= inst->Operands.size(); j++)
             {
-                buildSymbolicImmediate(context, module, inst->first, inst->second, 1, dest,
-                                       symbolicInfo);
+                uint64_t operandCode = inst->Operands[j - 1];
+                switch(decodedInstructions.kind(operandCode))
+                {
+                    case DecodedInstructions::OperandKind::Immediate:
+                        planSymbolicImmediate(module, inst->EA, *inst, j,
+                                              decodedInstructions.Immediates[operandCode],
+                                              symbolicInfo, expressions);
+                        break;
+                    case DecodedInstructions::OperandKind::Indirect:
+                        planSymbolicIndirect(module, inst->EA, *inst, j, symbolicInfo,
+                                             expressions);
+                        break;
+                    case DecodedInstructions::OperandKind::None:
+                        break;
+                }
             }
-            if(Load.NextEA == inst->first)
+            for(auto &Load : splitLoad)
             {
-                buildSymbolicImmediate(context, module, inst->first, inst->second, 2, dest,
-                                       symbolicInfo);
+                ImmOp dest = Load.Dest;
+                if(Load.EA == inst->EA)
+                {
+                    planSymbolicImmediate(module, inst->EA, *inst, 1, dest, symbolicInfo,
+                                          expressions);
+                }
+                if(Load.NextEA == inst->EA)
+                {
+                    planSymbolicImmediate(module, inst->EA, *inst, 2, dest, symbolicInfo,
+                                          expressions);
+                }
             }
         }
+    });
+
+    // Symbols and symbolic expressions are created serially, in address
+    // order, so that the resulting module does not depend on the threads.
+    for(const std::vector<CodeExpression> &expressions : chunks)
+    {
+        for(const CodeExpression &expr : expressions)
+        {
+            gtirb::Symbol *sym = expr.Symbol ? expr.Symbol : symbols.get(expr.Target);
+            addSymbolicExpressionToCodeBlock<gtirb::SymAddrConst>(
+                module, index, expr.EA, expr.Size, expr.Offset, expr.Addend, sym);
+        }
     }
 }
 
-void buildCodeBlocks(gtirb::Context &context, gtirb::Module &module, souffle::SouffleProgram *prog)
+void buildCodeBlocks(gtirb::Context &context, const ModuleIndex &index,
+                     souffle::SouffleProgram *prog)
 {
-    auto blockInformation =
-        convertSortedRelation<VectorByEA<BlockInformation>>("block_information", prog);
+    auto blockInformation = convertRelationByEA<BlockInformation>("block_information", prog);
     for(auto &output : *prog->getRelation("refined_block"))
     {
         gtirb::Addr blockAddress;
         output >> blockAddress;
-        if(auto sections = module.findSectionsOn(blockAddress); !sections.empty())
+        if(gtirb::ByteInterval *byteInterval = index.byteIntervalOn(blockAddress))
         {
-            gtirb::Section &section = *sections.begin();
             uint64_t size = blockInformation.find(blockAddress)->size;
-            if(auto it = section.findByteIntervalsOn(blockAddress); !it.empty())
-            {
-                if(gtirb::ByteInterval &byteInterval = *it.begin(); byteInterval.getAddress())
-                {
-                    uint64_t blockOffset = blockAddress - *byteInterval.getAddress();
-                    byteInterval.addBlock<gtirb::CodeBlock>(context, blockOffset, size);
-                }
-            }
+            uint64_t blockOffset = blockAddress - *byteInterval->getAddress();
+            byteInterval->addBlock<gtirb::CodeBlock>(context, blockOffset, size);
         }
     }
 }
@@ -747,7 +922,8 @@ void buildCodeBlocks(gtirb::Context &context, gtirb::Module &module, souffle::So
 // Create DataObjects for labeled objects in the BSS sections, without adding
 // data to the ImageByteMap.
 
-void buildBSS(gtirb::Context &context, gtirb::Module &module, souffle::SouffleProgram *prog)
+void buildBSS(gtirb::Context &context, gtirb::Module &module, const ModuleIndex &index,
+              souffle::SouffleProgram *prog)
 {
     auto bssData = convertSortedRelation<std::set<gtirb::Addr>>("bss_data", prog);
     for(auto &output : *prog->getRelation("bss_section"))
@@ -766,125 +942,197 @@ void buildBSS(gtirb::Context &context, gtirb::Module &module, souffle::SoufflePr
         {
             auto next = i;
             next++;
-            if(auto it = module.findByteIntervalsOn(*i); !it.empty())
+            if(gtirb::ByteInterval *byteInterval = index.byteIntervalOn(*i))
             {
-                gtirb::ByteInterval &byteInterval = *it.begin();
-                uint64_t blockOffset = *i - byteInterval.getAddress().value();
-                byteInterval.addBlock<gtirb::DataBlock>(context, blockOffset,
-                                                        static_cast<uint64_t>(*next - *i));
+                uint64_t blockOffset = *i - byteInterval->getAddress().value();
+                byteInterval->addBlock<gtirb::DataBlock>(context, blockOffset,
+                                                         static_cast<uint64_t>(*next - *i));
             }
         }
     }
 }
 
-void buildDataBlocks(gtirb::Context &context, gtirb::Module &module, souffle::SouffleProgram *prog)
+// Data block of an initialized data segment. Blocks are planned concurrently
+// and added to the module afterwards, in address order. `Source' is the fact
+// that gives the contents of the block, if any.
+struct DataBlockPlan
 {
-    auto symbolicData = convertSortedRelation<VectorByEA<SymbolicData>>("symbolic_data", prog);
-    auto movedDataLabels =
-        convertSortedRelation<VectorByEA<MovedDataLabel>>("moved_data_label", prog);
-    auto symbolicExprs =
-        convertSortedRelation<VectorByEA<SymbolicExpr>>("symbolic_expr_from_relocation", prog);
-    auto symbolMinusSymbol =
-        convertSortedRelation<VectorByEA<SymbolMinusSymbol>>("symbol_minus_symbol", prog);
-
-    auto dataStrings = convertSortedRelation<VectorByEA<StringDataObject>>("string", prog);
+    gtirb::ByteInterval *ByteInterval;
+    uint64_t Offset;
+    uint64_t Size;
+    std::variant<std::monostate, const SymbolicExpr *, const MovedDataLabel *,
+                 const SymbolicData *, const SymbolMinusSymbol *, const StringDataObject *>
+        Source;
+    const SymbolSpecialType *SpecialType;
+};
+
+void buildDataBlocks(gtirb::Context &context, gtirb::Module &module, const ModuleIndex &index,
+                     SymbolResolver &symbols, souffle::SouffleProgram *prog, unsigned int threads)
+{
+    auto symbolicData = convertRelationByEA<SymbolicData>("symbolic_data", prog);
+    auto movedDataLabels = convertRelationByEA<MovedDataLabel>("moved_data_label", prog);
+    auto symbolicExprs = convertRelationByEA<SymbolicExpr>("symbolic_expr_from_relocation", prog);
+    auto symbolMinusSymbol = convertRelationByEA<SymbolMinusSymbol>("symbol_minus_symbol", prog);
+
+    auto dataStrings = convertRelationByEA<StringDataObject>("string", prog);
     auto symbolSpecialTypes =
-        convertSortedRelation<VectorByEA<SymbolSpecialType>>("symbol_special_encoding", prog);
-    auto DataBoundary = convertSortedRelation<std::set<gtirb::Addr>>("data_object_boundary", prog);
+        convertRelationByEA<SymbolSpecialType>("symbol_special_encoding", prog);
+    std::vector<gtirb::Addr> DataBoundary;
+    for(auto &output : *prog->getRelation("data_object_boundary"))
+    {
+        DataBoundary.push_back(gtirb::Addr(output[0]));
+    }
     std::map<gtirb::UUID, std::string> typesTable;
 
     std::map<gtirb::Offset, uint64_t> SymbolicSizes;
 
+    std::vector<std::pair<gtirb::Addr, gtirb::Addr>> segments;
     for(auto &output : *prog->getRelation("initialized_data_segment"))
     {
         gtirb::Addr begin, end;
         output >> begin >> end;
+        segments.emplace_back(begin, end);
         // we don't create data blocks that exceed the data segment
-        DataBoundary.insert(end);
+        DataBoundary.push_back(end);
+    }
+    // do not cross byte intervals.
+    for(const gtirb::ByteInterval &byteInterval : module.byte_intervals())
+    {
+        if(byteInterval.getAddress())
+        {
+            DataBoundary.push_back(*byteInterval.getAddress() + byteInterval.getSize());
+        }
+    }
+    std::sort(DataBoundary.begin(), DataBoundary.end());
+    DataBoundary.erase(std::unique(DataBoundary.begin(), DataBoundary.end()), DataBoundary.end());
+
+    // Plan the data blocks of each segment concurrently: this only reads the
+    // module and the relations.
+    std::vector<std::vector<DataBlockPlan>> plans(segments.size());
+    parallelFor(segments.size(), threads, [&](size_t segment) {
+        auto [begin, end] = segments[segment];
+        // The data blocks of a segment are built in address order, so a single
+        // sweep advances the cursors of all the relations together, and the
+        // byte interval of the previous block is looked up again only when the
+        // current address leaves it.
+        CursorByEA<SymbolicExpr> symbolicExprCursor(symbolicExprs, begin);
+        CursorByEA<MovedDataLabel> movedDataLabelCursor(movedDataLabels, begin);
+        CursorByEA<SymbolicData> symbolicCursor(symbolicData, begin);
+        CursorByEA<SymbolMinusSymbol> symMinusSymCursor(symbolMinusSymbol, begin);
+        CursorByEA<StringDataObject> strCursor(dataStrings, begin);
+        CursorByEA<SymbolSpecialType> specialTypeCursor(symbolSpecialTypes, begin);
+        auto NextDataObject = std::upper_bound(DataBoundary.begin(), DataBoundary.end(), begin);
+        gtirb::ByteInterval *currentInterval = nullptr;
         for(auto currentAddr = begin; currentAddr < end;
             /*incremented in each case*/)
         {
-            gtirb::DataBlock *d;
-            if(auto it = module.findByteIntervalsOn(currentAddr); !it.empty())
+            if(!currentInterval || currentAddr < *currentInterval->getAddress()
+               || currentAddr >= *currentInterval->getAddress() + currentInterval->getSize())
+            {
+                currentInterval = index.byteIntervalOn(currentAddr);
+            }
+            if(!currentInterval || !currentInterval->getAddress())
+            {
+                break;
+            }
+            DataBlockPlan block{currentInterval,
+                                static_cast<uint64_t>(currentAddr - *currentInterval->getAddress()),
+                                0, std::monostate{}, nullptr};
+            // symbolic expression created from relocation
+            if(const SymbolicExpr *symbolicExpr = symbolicExprCursor.at(currentAddr))
+            {
+                block.Size = symbolicExpr->Size;
+                block.Source = symbolicExpr;
+            }
+            // symbol+constant
+            else if(const MovedDataLabel *movedDataLabel = movedDataLabelCursor.at(currentAddr))
+            {
+                block.Size = movedDataLabel->Size;
+                block.Source = movedDataLabel;
+            }
+            // symbol+0
+            else if(const SymbolicData *symbolic = symbolicCursor.at(currentAddr))
+            {
+                block.Size = symbolic->Size;
+                block.Source = symbolic;
+            }
+            // symbol-symbol
+            else if(const SymbolMinusSymbol *symMinusSym = symMinusSymCursor.at(currentAddr))
             {
-                if(gtirb::ByteInterval &byteInterval = *it.begin(); byteInterval.getAddress())
+                block.Size = symMinusSym->Size;
+                block.Source = symMinusSym;
+            }
+            // string
+            else if(const StringDataObject *str = strCursor.at(currentAddr))
+            {
+                block.Size = str->End - currentAddr;
+                block.Source = str;
+            }
+            else
+            {
+                // Accumulate region with no symbols into a single DataBlock.
+                while(*NextDataObject <= currentAddr)
                 {
-                    // do not cross byte intervals.
-                    DataBoundary.insert(*byteInterval.getAddress() + byteInterval.getSize());
-                    uint64_t blockOffset = currentAddr - *byteInterval.getAddress();
-                    gtirb::Offset Offset = gtirb::Offset(byteInterval.getUUID(), blockOffset);
-
-                    // symbolic expression created from relocation
-                    if(const auto symbolicExpr = symbolicExprs.find(currentAddr);
-                       symbolicExpr != symbolicExprs.end())
-                    {
-                        d = gtirb::DataBlock::Create(context, symbolicExpr->Size);
-                        auto foundSymbol = module.findSymbols(symbolicExpr->Symbol);
-                        if(foundSymbol.begin() != foundSymbol.end())
-                            byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(
-                                blockOffset, symbolicExpr->Addend, &*foundSymbol.begin());
-                        SymbolicSizes[Offset] = symbolicExpr->Size;
-                    }
-                    else
-                        // symbol+constant
-                        if(const auto movedDataLabel = movedDataLabels.find(currentAddr);
-                           movedDataLabel != movedDataLabels.end())
-                    {
-                        d = gtirb::DataBlock::Create(context, movedDataLabel->Size);
-                        auto diff = movedDataLabel->Address1 - movedDataLabel->Address2;
-                        auto sym =
-                            getSymbol(context, module, gtirb::Addr(movedDataLabel->Address2));
-                        byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(blockOffset, diff,
-                                                                                sym);
-                        SymbolicSizes[Offset] = movedDataLabel->Size;
-                    }
-                    else
-                        // symbol+0
-                        if(const auto symbolic = symbolicData.find(currentAddr);
-                           symbolic != symbolicData.end())
-                    {
-                        d = gtirb::DataBlock::Create(context, symbolic->Size);
-                        auto sym = getSymbol(context, module, symbolic->GroupContent);
-                        byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(blockOffset, 0,
-                                                                                sym);
-                        SymbolicSizes[Offset] = symbolic->Size;
-                    }
-                    else
-                        // symbol-symbol
-                        if(const auto symMinusSym = symbolMinusSymbol.find(currentAddr);
-                           symMinusSym != symbolMinusSymbol.end())
-                    {
-                        d = gtirb::DataBlock::Create(context, symMinusSym->Size);
-                        byteInterval.addSymbolicExpression<gtirb::SymAddrAddr>(
-                            blockOffset, symMinusSym->Scale, 0,
-                            getSymbol(context, module, symMinusSym->Symbol2),
-                            getSymbol(context, module, symMinusSym->Symbol1));
-                        SymbolicSizes[Offset] = symMinusSym->Size;
-                    }
-                    else
-                        // string
-                        if(const auto str = dataStrings.find(currentAddr); str != dataStrings.end())
-                    {
-                        d = gtirb::DataBlock::Create(context, str->End - currentAddr);
-                        typesTable[d->getUUID()] = std::string{"string"};
-                    }
-                    else
-                    {
-                        // Accumulate region with no symbols into a single DataBlock.
-                        auto NextDataObject = DataBoundary.lower_bound(currentAddr + 1);
-                        d = gtirb::DataBlock::Create(context, *NextDataObject - currentAddr);
-                    }
-                    // symbol special types
-                    const auto specialType = symbolSpecialTypes.find(currentAddr);
-                    if(specialType != symbolSpecialTypes.end())
-                        typesTable[d->getUUID()] = specialType->Type;
-                    byteInterval.addBlock(blockOffset, d);
-                    currentAddr += d->getSize();
+                    ++NextDataObject;
                 }
+                block.Size = *NextDataObject - currentAddr;
             }
+            // symbol special types
+            block.SpecialType = specialTypeCursor.at(currentAddr);
+            plans[segment].push_back(block);
+            currentAddr += block.Size;
+        }
+    });
+
+    // Blocks, symbols and symbolic expressions are created serially, in
+    // address order, so that the resulting module does not depend on the
+    // threads.
+    for(const std::vector<DataBlockPlan> &plan : plans)
+    {
+        for(const DataBlockPlan &block : plan)
+        {
+            gtirb::ByteInterval &byteInterval = *block.ByteInterval;
+            uint64_t blockOffset = block.Offset;
+            gtirb::Offset Offset = gtirb::Offset(byteInterval.getUUID(), blockOffset);
+            gtirb::DataBlock *d = gtirb::DataBlock::Create(context, block.Size);
+            if(auto symbolicExpr = std::get_if<const SymbolicExpr *>(&block.Source))
+            {
+                auto foundSymbol = module.findSymbols((*symbolicExpr)->Symbol);
+                if(foundSymbol.begin() != foundSymbol.end())
+                    byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(
+                        blockOffset, (*symbolicExpr)->Addend, &*foundSymbol.begin());
+                SymbolicSizes[Offset] = block.Size;
+            }
+            else if(auto movedDataLabel = std::get_if<const MovedDataLabel *>(&block.Source))
+            {
+                auto diff = (*movedDataLabel)->Address1 - (*movedDataLabel)->Address2;
+                auto sym = symbols.get(gtirb::Addr((*movedDataLabel)->Address2));
+                byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(blockOffset, diff, sym);
+                SymbolicSizes[Offset] = block.Size;
+            }
+            else if(auto symbolic = std::get_if<const SymbolicData *>(&block.Source))
+            {
+                auto sym = symbols.get((*symbolic)->GroupContent);
+                byteInterval.addSymbolicExpression<gtirb::SymAddrConst>(blockOffset, 0, sym);
+                SymbolicSizes[Offset] = block.Size;
+            }
+            else if(auto symMinusSym = std::get_if<const SymbolMinusSymbol *>(&block.Source))
+            {
+                byteInterval.addSymbolicExpression<gtirb::SymAddrAddr>(
+                    blockOffset, (*symMinusSym)->Scale, 0, symbols.get((*symMinusSym)->Symbol2),
+                    symbols.get((*symMinusSym)->Symbol1));
+                SymbolicSizes[Offset] = block.Size;
+            }
+            else if(std::holds_alternative<const StringDataObject *>(block.Source))
+            {
+                typesTable[d->getUUID()] = std::string{"string"};
+            }
+            if(block.SpecialType)
+                typesTable[d->getUUID()] = block.SpecialType->Type;
+            byteInterval.addBlock(blockOffset, d);
         }
     }
-    buildBSS(context, module, prog);
+    buildBSS(context, module, index, prog);
     module.addAuxData<gtirb::schema::Encodings>(std::move(typesTable));
     module.addAuxData<gtirb::schema::SymbolicExpressionSizes>(std::move(SymbolicSizes));
 }
@@ -903,49 +1151,104 @@ gtirb::Section *findSectionByIndex(gtirb::Context &C, gtirb::Module &M, uint64_t
     return nullptr;
 };
 
+// Cursor over the blocks of a module sorted by address, for addresses that
+// are visited in increasing order.
+template <typename BlockType>
+class BlockCursor
+{
+public:
+    template <typename Range>
+    explicit BlockCursor(Range &&Blocks)
+    {
+        for(BlockType &Block : Blocks)
+        {
+            if(Block.getAddress())
+            {
+                Sorted.push_back(&Block);
+            }
+        }
+        auto Compare = [](const BlockType *A, const BlockType *B) {
+            return *A->getAddress() < *B->getAddress();
+        };
+        // GTIRB already iterates blocks in address order.
+        if(!std::is_sorted(Sorted.begin(), Sorted.end(), Compare))
+        {
+            std::stable_sort(Sorted.begin(), Sorted.end(), Compare);
+        }
+        It = Sorted.begin();
+    }
+
+    // First block that starts at the address A.
+    BlockType *at(gtirb::Addr A)
+    {
+        advance(A);
+        return It != Sorted.end() && *(*It)->getAddress() == A ? *It : nullptr;
+    }
+
+    // Whether a block that starts before the address A contains it.
+    bool inside(gtirb::Addr A)
+    {
+        advance(A);
+        return MaxEnd > A;
+    }
+
+private:
+    void advance(gtirb::Addr A)
+    {
+        for(; It != Sorted.end() && *(*It)->getAddress() < A; ++It)
+        {
+            MaxEnd = std::max(MaxEnd, *(*It)->getAddress() + (*It)->getSize());
+        }
+    }
+
+    std::vector<BlockType *> Sorted;
+    typename std::vector<BlockType *>::const_iterator It;
+    // End of the blocks before It.
+    gtirb::Addr MaxEnd{0};
+};
+
 void connectSymbolsToBlocks(gtirb::Context &Context, gtirb::Module &Module)
 {
     auto *SymbolInfo = Module.getAuxData<gtirb::schema::ElfSymbolInfoAD>();
 
-    std::map<gtirb::Symbol *, std::tuple<gtirb::Node *, bool>> ConnectToBlock;
+    // Symbols are visited in address order, so a single sweep advances the
+    // cursors of the code and data blocks together.
+    BlockCursor<gtirb::CodeBlock> CodeBlocks(Module.code_blocks());
+    BlockCursor<gtirb::DataBlock> DataBlocks(Module.data_blocks());
+
+    struct Connection
+    {
+        gtirb::Symbol *Symbol;
+        gtirb::Node *Block;
+        bool AtEnd;
+    };
+    std::vector<Connection> ConnectToBlock;
     for(auto &Symbol : Module.symbols_by_addr())
     {
         if(Symbol.getAddress())
         {
             gtirb::Addr Addr = *Symbol.getAddress();
-            if(auto It = Module.findCodeBlocksAt(Addr); !It.empty())
+            if(gtirb::CodeBlock *Block = CodeBlocks.at(Addr))
             {
-                gtirb::CodeBlock &Block = It.front();
-                assert(Addr == *Block.getAddress());
-                ConnectToBlock[&Symbol] = {&Block, false};
+                ConnectToBlock.push_back({&Symbol, Block, false});
                 continue;
             }
-            if(auto It = Module.findDataBlocksAt(Addr); !It.empty())
+            if(gtirb::DataBlock *Block = DataBlocks.at(Addr))
             {
-                gtirb::DataBlock &Block = It.front();
-                assert(Addr == *Block.getAddress());
-                ConnectToBlock[&Symbol] = {&Block, false};
+                ConnectToBlock.push_back({&Symbol, Block, false});
                 continue;
             }
-            if(auto It = Module.findCodeBlocksOn(Addr); !It.empty())
+            if(CodeBlocks.inside(Addr))
             {
-                gtirb::CodeBlock &Block = It.front();
-                if(Addr > *Block.getAddress())
-                {
-                    std::cerr << "WARNING: Found integral symbol pointing into existing block:"
-                              << Symbol.getName() << std::endl;
-                    continue;
-                }
+                std::cerr << "WARNING: Found integral symbol pointing into existing block:"
+                          << Symbol.getName() << std::endl;
+                continue;
             }
-            if(auto It = Module.findDataBlocksOn(Addr); !It.empty())
+            if(DataBlocks.inside(Addr))
             {
-                gtirb::DataBlock &Block = It.front();
-                if(Addr > *Block.getAddress())
-                {
-                    std::cerr << "WARNING: Found integral symbol pointing into existing block: "
-                              << Symbol.getName() << std::endl;
-                    continue;
-                }
+                std::cerr << "WARNING: Found integral symbol pointing into existing block: "
+                          << Symbol.getName() << std::endl;
+                continue;
             }
             if(auto It = Module.findSectionsOn(Addr - 1); !It.empty())
             {
@@ -957,7 +1260,7 @@ void connectSymbolsToBlocks(gtirb::Context &Context, gtirb::Module &Module)
                         if(auto BlockIt = Section.findBlocksOn(Addr - 1); !BlockIt.empty())
                         {
                             gtirb::Node &Block = BlockIt.front();
-                            ConnectToBlock[&Symbol] = {&Block, true};
+                            ConnectToBlock.push_back({&Symbol, &Block, true});
                             continue;
                         }
                     }
@@ -976,7 +1279,7 @@ void connectSymbolsToBlocks(gtirb::Context &Context, gtirb::Module &Module)
                         {
                             std::cerr << "WARNING: Moving symbol to first block of section: "
                                       << Symbol.getName() << std::endl;
-                            ConnectToBlock[&Symbol] = {&*It.begin(), false};
+                            ConnectToBlock.push_back({&Symbol, &*It.begin(), false});
                             continue;
                         }
                     }
@@ -985,9 +1288,8 @@ void connectSymbolsToBlocks(gtirb::Context &Context, gtirb::Module &Module)
         }
     }
 
-    for(auto [Symbol, T] : ConnectToBlock)
+    for(auto [Symbol, Node, AtEnd] : ConnectToBlock)
     {
-        auto [Node, AtEnd] = T;
         if(gtirb::CodeBlock *CodeBlock = dyn_cast_or_null<gtirb::CodeBlock>(Node))
         {
             Symbol->setReferent(CodeBlock);
@@ -1003,28 +1305,29 @@ void connectSymbolsToBlocks(gtirb::Context &Context, gtirb::Module &Module)
     Module.removeAuxData<gtirb::schema::ElfSectionIndex>();
 }
 
-void buildFunctions(gtirb::Module &module, souffle::SouffleProgram *prog)
+void buildFunctions(gtirb::Module &module, const ModuleIndex &index,
+                    souffle::SouffleProgram *prog)
 {
     std::map<gtirb::UUID, std::set<gtirb::UUID>> functionEntries;
     std::map<gtirb::Addr, gtirb::UUID> functionEntry2function;
     std::map<gtirb::UUID, gtirb::UUID> functionNames;
-    boost::uuids::random_generator generator;
+    UUIDGenerator generator(module, "function");
     for(auto &output : *prog->getRelation("function_inference.function_entry"))
     {
         gtirb::Addr functionEntry;
         output >> functionEntry;
-        auto blockRange = module.findCodeBlocksAt(functionEntry);
-        if(!blockRange.empty())
+        if(const gtirb::CodeBlock *entryBlock = index.codeBlockAt(functionEntry))
         {
-            const gtirb::UUID &entryBlockUUID = blockRange.begin()->getUUID();
-            gtirb::UUID functionUUID = generator();
+            const gtirb::UUID &entryBlockUUID = entryBlock->getUUID();
+            gtirb::UUID functionUUID = generator(functionEntry);
 
             functionEntry2function[functionEntry] = functionUUID;
             functionEntries[functionUUID].insert(entryBlockUUID);
 
-            for(const auto &symbol : module.findSymbols(functionEntry))
+            auto [symbolsBegin, symbolsEnd] = index.symbols(functionEntry);
+            for(auto symbol = symbolsBegin; symbol != symbolsEnd; symbol++)
             {
-                functionNames.insert({functionUUID, symbol.getUUID()});
+                functionNames.insert({functionUUID, symbol->second->getUUID()});
             }
         }
     }
@@ -1034,10 +1337,8 @@ void buildFunctions(gtirb::Module &module, souffle::SouffleProgram *prog)
     {
         gtirb::Addr blockAddr, functionEntryAddr;
         output >> blockAddr >> functionEntryAddr;
-        auto blockRange = module.findCodeBlocksOn(blockAddr);
-        if(!blockRange.empty())
+        if(gtirb::CodeBlock *block = index.codeBlockOn(blockAddr))
         {
-            gtirb::CodeBlock *block = &*blockRange.begin();
             gtirb::UUID functionEntryUUID = functionEntry2function[functionEntryAddr];
             functionBlocks[functionEntryUUID].insert(block->getUUID());
         }
@@ -1060,9 +1361,14 @@ gtirb::EdgeType getEdgeType(const std::string &type)
     return gtirb::EdgeType::Fallthrough;
 }
 
-void buildCFG(gtirb::Context &context, gtirb::Module &module, souffle::SouffleProgram *prog)
+void buildCFG(gtirb::Context &context, gtirb::Module &module, const ModuleIndex &index,
+              souffle::SouffleProgram *prog)
 {
     auto &cfg = module.getIR()->getCFG();
+    // Edges are sorted by source, so consecutive edges often leave the same
+    // block.
+    gtirb::Addr lastSrcAddr;
+    const gtirb::CodeBlock *src = nullptr;
     for(auto &output : *prog->getRelation("cfg_edge"))
     {
         gtirb::Addr srcAddr, destAddr;
@@ -1070,8 +1376,12 @@ void buildCFG(gtirb::Context &context, gtirb::Module &module, souffle::SoufflePr
         output >> srcAddr >> destAddr >> conditional >> indirect >> type;
 
         // ddisasm guarantees that these blocks exist
-        const gtirb::CodeBlock *src = &*module.findCodeBlocksOn(srcAddr).begin();
-        const gtirb::CodeBlock *dest = &*module.findCodeBlocksOn(destAddr).begin();
+        if(!src || srcAddr != lastSrcAddr)
+        {
+            src = index.codeBlockOn(srcAddr);
+            lastSrcAddr = srcAddr;
+        }
+        const gtirb::CodeBlock *dest = index.codeBlockOn(destAddr);
 
         auto isConditional = conditional == "true" ? gtirb::ConditionalEdge::OnTrue
                                                    : gtirb::ConditionalEdge::OnFalse;
@@ -1088,7 +1398,7 @@ void buildCFG(gtirb::Context &context, gtirb::Module &module, souffle::SoufflePr
         gtirb::Addr srcAddr;
         std::string conditional, type;
         output >> srcAddr >> conditional >> type;
-        const gtirb::CodeBlock *src = &*module.findCodeBlocksOn(srcAddr).begin();
+        const gtirb::CodeBlock *src = index.codeBlockOn(srcAddr);
         auto isConditional = conditional == "true" ? gtirb::ConditionalEdge::OnTrue
                                                    : gtirb::ConditionalEdge::OnFalse;
         gtirb::EdgeType edgeType = getEdgeType(type);
@@ -1100,7 +1410,7 @@ void buildCFG(gtirb::Context &context, gtirb::Module &module, souffle::SoufflePr
         gtirb::Addr srcAddr;
         std::string symbolName;
         output >> srcAddr >> symbolName;
-        const gtirb::CodeBlock *src = &*module.findCodeBlocksOn(srcAddr).begin();
+        const gtirb::CodeBlock *src = index.codeBlockOn(srcAddr);
         gtirb::Symbol &symbol = *module.findSymbols(symbolName).begin();
         gtirb::ProxyBlock *externalBlock = symbol.getReferent<gtirb::ProxyBlock>();
         // if the symbol does not point to a ProxyBlock yet, we create it
@@ -1117,40 +1427,23 @@ void buildCFG(gtirb::Context &context, gtirb::Module &module, souffle::SoufflePr
 
 // In general, it is expected that findOffsets returns a vector with zero or one items
 // because blocks and data objects typically do not overlap.
-std::vector<gtirb::Offset> findOffsets(gtirb::Module &module, gtirb::Addr ea)
+std::vector<gtirb::Offset> findOffsets(const ModuleIndex &index, gtirb::Addr ea)
 {
     std::vector<gtirb::Offset> offsets;
-    for(auto &block : module.findCodeBlocksOn(ea))
+    for(gtirb::CodeBlock *block : index.codeBlocksOn(ea))
     {
-        offsets.push_back(gtirb::Offset(block.getUUID(), ea - block.getAddress().value()));
+        offsets.push_back(gtirb::Offset(block->getUUID(), ea - block->getAddress().value()));
     }
-    for(auto &dataObject : module.findDataBlocksOn(ea))
+    for(gtirb::DataBlock *dataObject : index.dataBlocksOn(ea))
     {
         offsets.push_back(
-            gtirb::Offset(dataObject.getUUID(), ea - dataObject.getAddress().value()));
+            gtirb::Offset(dataObject->getUUID(), ea - dataObject->getAddress().value()));
     }
     return offsets;
 }
 
-void updateComment(gtirb::Module &module, std::map<gtirb::Offset, std::string> &comments,
-                   gtirb::Addr ea, std::string newComment)
-{
-    std::vector<gtirb::Offset> matchingOffsets = findOffsets(module, ea);
-    for(gtirb::Offset &offset : matchingOffsets)
-    {
-        auto existing = comments.find(offset);
-        if(existing != comments.end())
-        {
-            existing->second += ", ";
-            existing->second += newComment;
-        }
-        else
-            comments[offset] = newComment;
-    }
-}
-
-void buildCfiDirectives(gtirb::Context &context, gtirb::Module &module,
-                        souffle::SouffleProgram *prog)
+void buildCfiDirectives(gtirb::Module &module, const ModuleIndex &index,
+                        SymbolResolver &symbols, souffle::SouffleProgram *prog)
 {
     std::map<gtirb::Offset, std::vector<std::tuple<std::string, std::vector<int64_t>, gtirb::UUID>>>
         cfiDirectives;
@@ -1167,9 +1460,9 @@ void buildCfiDirectives(gtirb::Context &context, gtirb::Module &module,
         // dwarf instruction). The address 'reference' points to these bytes.
         if(directive == ".cfi_escape")
         {
-            if(const auto it = module.findByteIntervalsOn(reference); !it.empty())
+            if(const gtirb::ByteInterval *it = index.byteIntervalOn(reference))
             {
-                if(const gtirb::ByteInterval &interval = *it.begin(); interval.getAddress())
+                if(const gtirb::ByteInterval &interval = *it; interval.getAddress())
                 {
                     auto begin =
                         interval.bytes_begin<uint8_t>() + (reference - *interval.getAddress());
@@ -1189,17 +1482,17 @@ void buildCfiDirectives(gtirb::Context &context, gtirb::Module &module,
                 operands.push_back(op2);
         }
 
-        auto blockRange = module.findCodeBlocksOn(blockAddr);
-        if(blockRange.begin() != blockRange.end() && blockAddr == blockRange.begin()->getAddress())
+        const gtirb::CodeBlock *block = index.codeBlockOn(blockAddr);
+        if(block && blockAddr == block->getAddress())
         {
-            gtirb::Offset offset(blockRange.begin()->getUUID(), disp);
+            gtirb::Offset offset(block->getUUID(), disp);
             if(cfiDirectives[offset].size() < localIndex + 1)
                 cfiDirectives[offset].resize(localIndex + 1);
 
             if(directive != ".cfi_escape" && reference != gtirb::Addr(0))
             {
                 // for normal directives (not cfi_escape) the reference points to a symbol.
-                gtirb::Symbol *symbol = getSymbol(context, module, reference);
+                gtirb::Symbol *symbol = symbols.get(reference);
                 cfiDirectives[offset][localIndex] =
                     std::make_tuple(directive, operands, symbol->getUUID());
             }
@@ -1213,7 +1506,7 @@ void buildCfiDirectives(gtirb::Context &context, gtirb::Module &module,
     module.addAuxData<gtirb::schema::CfiDirectives>(std::move(cfiDirectives));
 }
 
-void buildPadding(gtirb::Module &Module, souffle::SouffleProgram *Prog)
+void buildPadding(gtirb::Module &Module, const ModuleIndex &Index, souffle::SouffleProgram *Prog)
 {
     std::map<gtirb::Offset, uint64_t> Padding;
     for(auto &Output : *Prog->getRelation("padding"))
@@ -1221,9 +1514,9 @@ void buildPadding(gtirb::Module &Module, souffle::SouffleProgram *Prog)
         gtirb::Addr EA;
         uint64_t Size;
         Output >> EA >> Size;
-        if(auto It = Module.findByteIntervalsOn(EA); !It.empty())
+        if(gtirb::ByteInterval *It = Index.byteIntervalOn(EA))
         {
-            if(gtirb::ByteInterval &ByteInterval = *It.begin(); ByteInterval.getAddress())
+            if(gtirb::ByteInterval &ByteInterval = *It; ByteInterval.getAddress())
             {
                 uint64_t BlockOffset = EA - *ByteInterval.getAddress();
                 gtirb::Offset Offset = gtirb::Offset(ByteInterval.getUUID(), BlockOffset);
@@ -1234,9 +1527,12 @@ void buildPadding(gtirb::Module &Module, souffle::SouffleProgram *Prog)
     Module.addAuxData<gtirb::schema::Padding>(std::move(Padding));
 }
 
-void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool selfDiagnose)
+void buildComments(gtirb::Module &module, const ModuleIndex &index, souffle::SouffleProgram *prog,
+                   bool selfDiagnose)
 {
-    std::map<gtirb::Offset, std::string> comments;
+    // Comments are collected with their address and attached to the blocks
+    // of each address at once.
+    std::vector<std::pair<gtirb::Addr, std::string>> newComments;
     for(auto &output : *prog->getRelation("data_access_pattern"))
     {
         gtirb::Addr ea;
@@ -1246,7 +1542,7 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         std::ostringstream newComment;
         newComment << "data_access(" << size << ", " << multiplier << ", " << std::hex << from
                    << std::dec << ")";
-        updateComment(module, comments, ea, newComment.str());
+        newComments.emplace_back(ea, newComment.str());
     }
 
     for(auto &output : *prog->getRelation("preferred_data_access"))
@@ -1256,7 +1552,7 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         output >> ea >> data_access;
         std::ostringstream newComment;
         newComment << "preferred_data_access(" << std::hex << data_access << std::dec << ")";
-        updateComment(module, comments, ea, newComment.str());
+        newComments.emplace_back(ea, newComment.str());
     }
 
     for(auto &output : *prog->getRelation("best_value_reg"))
@@ -1268,7 +1564,7 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         std::ostringstream newComment;
         newComment << reg << "=X*" << multiplier << "+" << std::hex << offset << std::dec
                    << " type(" << type << ")";
-        updateComment(module, comments, ea, newComment.str());
+        newComments.emplace_back(ea, newComment.str());
     }
 
     for(auto &output : *prog->getRelation("value_reg"))
@@ -1280,7 +1576,7 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         std::ostringstream newComment;
         newComment << reg << "=(" << reg2 << "," << std::hex << ea2 << std::dec << ")*"
                    << multiplier << "+" << std::hex << offset << std::dec;
-        updateComment(module, comments, ea, newComment.str());
+        newComments.emplace_back(ea, newComment.str());
     }
 
     for(auto &output : *prog->getRelation("moved_label_class"))
@@ -1292,18 +1588,18 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         output >> ea >> opIndex >> type;
         std::ostringstream newComment;
         newComment << " moved label-" << type;
-        updateComment(module, comments, ea, newComment.str());
+        newComments.emplace_back(ea, newComment.str());
     }
 
     for(auto &output : *prog->getRelation("def_used"))
     {
         gtirb::Addr ea_use;
-        int64_t ea_def, index;
+        int64_t ea_def, useIndex;
         std::string reg;
-        output >> ea_def >> reg >> ea_use >> index;
+        output >> ea_def >> reg >> ea_use >> useIndex;
         std::ostringstream newComment;
         newComment << "def(" << reg << ", " << std::hex << ea_def << std::dec << ")";
-        updateComment(module, comments, ea_use, newComment.str());
+        newComments.emplace_back(ea_use, newComment.str());
     }
     if(selfDiagnose)
     {
@@ -1311,64 +1607,132 @@ void buildComments(gtirb::Module &module, souffle::SouffleProgram *prog, bool se
         {
             gtirb::Addr ea;
             output >> ea;
-            updateComment(module, comments, ea, "false positive");
+            newComments.emplace_back(ea, "false positive");
         }
         for(auto &output : *prog->getRelation("false_negative"))
         {
             gtirb::Addr ea;
             output >> ea;
-            updateComment(module, comments, ea, "false negative");
+            newComments.emplace_back(ea, "false negative");
         }
         for(auto &output : *prog->getRelation("bad_symbol_constant"))
         {
             gtirb::Addr ea;
-            int64_t index;
-            output >> ea >> index;
+            int64_t operandIndex;
+            output >> ea >> operandIndex;
             std::ostringstream newComment;
-            newComment << "bad_symbol_constant(" << index << ")";
-            updateComment(module, comments, ea, newComment.str());
+            newComment << "bad_symbol_constant(" << operandIndex << ")";
+            newComments.emplace_back(ea, newComment.str());
+        }
+    }
+    // Comments at the same address keep the order in which they were added.
+    std::stable_sort(newComments.begin(), newComments.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::map<gtirb::Offset, std::string> comments;
+    for(auto it = newComments.begin(); it != newComments.end();)
+    {
+        gtirb::Addr ea = it->first;
+        std::string comment = std::move(it->second);
+        for(++it; it != newComments.end() && it->first == ea; ++it)
+        {
+            comment += ", ";
+            comment += it->second;
+        }
+        for(const gtirb::Offset &offset : findOffsets(index, ea))
+        {
+            comments.emplace(offset, comment);
         }
     }
     module.addAuxData<gtirb::schema::Comments>(std::move(comments));
 }
 
-void updateEntryPoint(gtirb::Module &module, souffle::SouffleProgram *prog)
+void updateEntryPoint(gtirb::Module &module, const ModuleIndex &index,
+                      souffle::SouffleProgram *prog)
 {
     for(auto &output : *prog->getRelation("entry_point"))
     {
         gtirb::Addr ea;
         output >> ea;
 
-        if(const auto it = module.findCodeBlocksAt(ea); !it.empty())
+        if(gtirb::CodeBlock *block = index.codeBlockAt(ea))
         {
-            module.setEntryPoint(&*it.begin());
+            module.setEntryPoint(block);
         }
     }
     assert(module.getEntryPoint() && "Failed to set module entry point.");
 }
 
+// Run a step of GTIRB population as a phase of the --stats-json report.
+template <typename F>
+static void step(const char *Name, F Fn)
+{
+    Stats::Phase Phase = Stats::instance().phase(std::string("populate/") + Name);
+    Fn();
+}
+
 void disassembleModule(gtirb::Context &context, gtirb::Module &module,
-                       souffle::SouffleProgram *prog, bool selfDiagnose)
+                       souffle::SouffleProgram *prog, bool selfDiagnose, unsigned int threads,
+                       bool comments)
 {
-    buildInferredSymbols(context, module, prog);
-    buildSymbolForwarding(context, module, prog);
-    buildSymbolicOperandInfo(context, module, prog);
-    buildCodeBlocks(context, module, prog);
-    buildDataBlocks(context, module, prog);
-    buildCodeSymbolicInformation(context, module, prog);
-    buildCfiDirectives(context, module, prog);
-    expandSymbolForwarding(context, module, prog);
+    ModuleIndex index(module);
+    SymbolResolver symbols(context, module, index);
+    step("buildInferredSymbols", [&]() { buildInferredSymbols(context, module, index, prog); });
+    step("buildSymbolForwarding",
+         [&]() { buildSymbolForwarding(context, module, index, prog); });
+    step("buildSymbolicOperandInfo", [&]() { buildSymbolicOperandInfo(context, module, prog); });
+    step("buildCodeBlocks", [&]() { buildCodeBlocks(context, index, prog); });
+    step("buildDataBlocks",
+         [&]() { buildDataBlocks(context, module, index, symbols, prog, threads); });
+    step("indexBlocks", [&]() { index.indexBlocks(); });
+    step("buildCodeSymbolicInformation",
+         [&]() { buildCodeSymbolicInformation(module, index, symbols, prog, threads); });
+    step("buildCfiDirectives", [&]() { buildCfiDirectives(module, index, symbols, prog); });
+    step("expandSymbolForwarding",
+         [&]() { expandSymbolForwarding(module, index, symbols, prog); });
     // This should be done after creating all the symbols.
-    connectSymbolsToBlocks(context, module);
+    step("connectSymbolsToBlocks", [&]() {
+        connectSymbolsToBlocks(context, module);
+        index.indexSymbols();
+    });
     // These functions should not create additional symbols.
-    buildFunctions(module, prog);
-    buildCFG(context, module, prog);
-    buildPadding(module, prog);
-    buildComments(module, prog, selfDiagnose);
-    updateEntryPoint(module, prog);
+    step("buildFunctions", [&]() { buildFunctions(module, index, prog); });
+    step("buildCFG", [&]() { buildCFG(context, module, index, prog); });
+    step("buildPadding", [&]() { buildPadding(module, index, prog); });
+    if(comments)
+    {
+        step("buildComments", [&]() { buildComments(module, index, prog, selfDiagnose); });
+    }
+    step("updateEntryPoint", [&]() { updateEntryPoint(module, index, prog); });
+}
+
+std::set<std::string> disassemblyRelations(bool selfDiagnose, bool comments)
+{
+    std::set<std::string> relations = {
+        // disassembleModule
+        "block_information", "bss_data", "bss_section", "cfg_edge", "cfg_edge_to_symbol",
+        "cfg_edge_to_top", "cfi_directive", "code_in_refined_block", "data_object_boundary",
+        "entry_point", "function_inference.function_entry", "function_inference.in_function",
+        "got_local_reference", "got_reference", "inferred_symbol_name",
+        "initialized_data_segment", "instruction_complete", "moved_data_label", "moved_label",
+        "op_immediate", "op_indirect", "padding", "plt_block", "refined_block", "relocation",
+        "split_load", "string", "symbol_minus_symbol", "symbol_prefix", "symbol_special_encoding",
+        "symbolic_data", "symbolic_expr_from_relocation", "symbolic_operand",
+        // performSanityChecks
+        "block_still_overlap"};
+    if(comments)
+    {
+        // buildComments
+        relations.insert({"best_value_reg", "data_access_pattern", "def_used",
+                          "moved_label_class", "preferred_data_access", "value_reg"});
+    }
+    if(selfDiagnose)
+    {
+        relations.insert({"bad_symbol_constant", "false_negative", "false_positive"});
+    }
+    return relations;
 }
 
-void performSanityChecks(souffle::SouffleProgram *prog, bool selfDiagnose)
+bool performSanityChecks(souffle::SouffleProgram *prog, bool selfDiagnose)
 {
     bool error = false;
     if(selfDiagnose)
@@ -1408,11 +1772,7 @@ void performSanityChecks(souffle::SouffleProgram *prog, bool selfDiagnose)
             std::cerr << std::hex << block1 << " - " << block2 << std::dec << std::endl;
         }
     }
-    if(error)
-    {
-        std::cerr << "Aborting" << std::endl;
-        exit(1);
-    }
     if(selfDiagnose && !error)
         std::cout << "Self diagnose completed: No errors found" << std::endl;
+    return !error;
 }
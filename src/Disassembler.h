@@ -21,14 +21,28 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+#include <string>
+
 #include <souffle/SouffleInterface.h>
 #include <gtirb/gtirb.hpp>
 
 #ifndef GTIRB_MODULE_DISASSEMBLER_H_
 #define GTIRB_MODULE_DISASSEMBLER_H_
 
+// Build the GTIRB module from the results of the disassembly program. Up to
+// `threads' threads are used to plan symbolic expressions and data blocks.
+// The Comments AuxData is only built if `comments' is set, which requires the
+// complete program: lean programs leave the relations it is built from empty.
 void disassembleModule(gtirb::Context &context, gtirb::Module &module,
-                       souffle::SouffleProgram *prog, bool selfDiagnose);
-void performSanityChecks(souffle::SouffleProgram *prog, bool selfDiagnose);
+                       souffle::SouffleProgram *prog, bool selfDiagnose,
+                       unsigned int threads = 1, bool comments = false);
+
+// Return false if the results of the analysis have errors.
+bool performSanityChecks(souffle::SouffleProgram *prog, bool selfDiagnose);
+
+// Relations of the disassembly program that are read by disassembleModule and
+// performSanityChecks.
+std::set<std::string> disassemblyRelations(bool selfDiagnose, bool comments);
 
 #endif // GTIRB_MODULE_DISASSEMBLER_H_
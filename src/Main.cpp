@@ -35,6 +35,9 @@
 
 #include <souffle/CompiledSouffle.h>
 #include <souffle/SouffleInterface.h>
+#if defined(DDISASM_SOUFFLE_PROFILE)
+#include <souffle/profile/ProfileEvent.h>
+#endif
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
@@ -43,6 +46,7 @@
 
 #include "gtirb-builder/GtirbBuilder.h"
 #include "gtirb-decoder/DatalogProgram.h"
+#include "gtirb-decoder/Stats.h"
 
 #include "AuxDataSchema.h"
 #include "Disassembler.h"
@@ -90,6 +94,19 @@ std::vector<std::string> createDisasmOptions(const po::variables_map &vm)
     return Options;
 }
 
+// Comments with the results of the analysis are only built on request.
+static bool commentsRequested(const po::variables_map &vm)
+{
+    return vm.count("comments") != 0 || vm.count("debug") != 0 || vm.count("debug-dir") != 0;
+}
+
+// The lean Datalog programs are used unless the relations that are only
+// needed for debugging, comments or self-diagnosis are requested.
+static bool useLeanProgram(const po::variables_map &vm)
+{
+    return !commentsRequested(vm) && vm.count("self-diagnose") == 0;
+}
+
 static bool isStdoutATerminal()
 {
 #if defined(_MSC_VER)
@@ -118,6 +135,90 @@ static void setStdoutToBinary()
     }
 }
 
+// Write the --stats-json report, if requested.
+static void writeStats(const po::variables_map &vm)
+{
+    if(vm.count("stats-json") != 0)
+    {
+        std::string name = vm["stats-json"].as<std::string>();
+        if(name == "-")
+        {
+            Stats::instance().write(std::cerr);
+        }
+        else
+        {
+            std::ofstream out(name);
+            Stats::instance().write(out);
+        }
+    }
+}
+
+// Select the file of the Souffle profile log. Every instrumented program sets
+// the log to its built-in file name when it runs, and the log of all programs
+// is written when the process exits, so this must follow the last run.
+static void setProfileLog(const po::variables_map &vm)
+{
+#if defined(DDISASM_SOUFFLE_PROFILE)
+    if(vm.count("profile") != 0)
+    {
+        souffle::ProfileEventSingleton::instance().setOutputFile(vm["profile"].as<std::string>());
+    }
+#endif
+}
+
+// Run the disassembly analysis on facts written to a debug dir by a previous
+// run, without building GTIRB for the binary.
+static int runFromFacts(const po::variables_map &vm)
+{
+    std::string Directory = vm["load-facts"].as<std::string>() + "/";
+    unsigned int NThreads = vm["threads"].as<unsigned int>();
+
+    std::cerr << "Loading facts " << std::flush;
+    auto StartLoad = std::chrono::high_resolution_clock::now();
+    Stats::Phase LoadPhase = Stats::instance().phase("load-facts");
+    std::optional<DatalogProgram> Souffle =
+        DatalogProgram::read(Directory, NThreads, useLeanProgram(vm));
+    LoadPhase.stop();
+    printElapsedTimeSince(StartLoad);
+    if(!Souffle)
+    {
+        std::cerr << "ERROR: " << Directory << ": could not load facts\n";
+        return 1;
+    }
+
+    std::cerr << "Disassembling" << std::flush;
+    auto StartDisassembling = std::chrono::high_resolution_clock::now();
+    Stats::Phase DatalogPhase = Stats::instance().phase("datalog");
+    try
+    {
+        Souffle->run();
+    }
+    catch(std::exception &e)
+    {
+        souffle::SignalHandler::instance()->error(e.what());
+    }
+    DatalogPhase.stop();
+    printElapsedTimeSince(StartDisassembling);
+    Stats::instance().relations(Souffle->get());
+
+    if(vm.count("debug-dir") != 0)
+    {
+        std::cerr << "Writing results to debug dir " << vm["debug-dir"].as<std::string>()
+                  << std::endl;
+        Stats::Phase Phase = Stats::instance().phase("write-relations");
+        Souffle->writeRelations(vm["debug-dir"].as<std::string>() + "/");
+    }
+    bool Sane = performSanityChecks(Souffle->get(), vm.count("self-diagnose") != 0);
+    writeStats(vm);
+    setProfileLog(vm);
+    if(!Sane)
+    {
+        std::cerr << "Aborting" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     registerAuxDataTypes();
@@ -134,6 +235,9 @@ int main(int argc, char **argv)
         "Specifies the ASM output file; use to '-' print to stdout")(
         "debug", "generate assembler file with debugging information")(
         "debug-dir", po::value<std::string>(), "location to write CSV files for debugging")(
+        "comments",
+        "Add comments with the results of the analysis to the instructions and data (implied "
+        "by --debug and --debug-dir)")(
         "input-file", po::value<std::string>(), "file to disasemble")(
         "keep-functions,K", po::value<std::vector<std::string>>()->multitoken(),
         "Print the given functions even if they are skipped by default (e.g. _start)")(
@@ -145,7 +249,20 @@ int main(int argc, char **argv)
         "no-cfi-directives",
         "Do not produce cfi directives. Instead it produces symbolic expressions in .eh_frame.")(
         "threads,j", po::value<unsigned int>()->default_value(std::thread::hardware_concurrency()),
-        "Number of cores to use. It is set to the number of cores in the machine by default");
+        "Number of cores to use. It is set to the number of cores in the machine by default")(
+        "decode-cache", po::value<std::string>(),
+        "Directory in which to cache decoded instructions for reuse across runs")(
+        "binary-facts", "Write the facts in the debug dir in binary form")(
+        "load-facts", po::value<std::string>(),
+        "Run the disassembly analysis on the facts of a debug dir instead of an input file")(
+        "stats-json", po::value<std::string>(),
+        "Write wall time, CPU time and peak memory of each phase of the run as JSON to the "
+        "given file; use '-' to print to stderr");
+#if defined(DDISASM_SOUFFLE_PROFILE)
+    desc.add_options()("profile", po::value<std::string>(),
+                       "Write the Souffle profile log (timing and tuple counts of each relation "
+                       "and rule) to the given file");
+#endif
     po::positional_options_description pd;
     pd.add("input-file", -1);
 
@@ -175,6 +292,30 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    if(vm.count("stats-json") != 0)
+    {
+        Stats::instance().enable();
+        Stats::instance().value("version", DDISASM_FULL_VERSION_STRING);
+        Stats::instance().value("threads", vm["threads"].as<unsigned int>());
+    }
+
+    if(vm.count("load-facts") != 0)
+    {
+        // No GTIRB is built from facts, so there is nothing to output.
+        for(const char *Output : {"ir", "json", "asm"})
+        {
+            if(vm.count(Output) != 0)
+            {
+                std::cerr << "Error: --" << Output << " cannot be used with --load-facts
+Try '"
+                          << argv[0] << " --help' for more information.
+";
+                return 1;
+            }
+        }
+        return runFromFacts(vm);
+    }
+
     if(vm.count("input-file") < 1)
     {
         std::cerr << "Error: missing input file\nTry '" << argv[0]
@@ -186,6 +327,13 @@ int main(int argc, char **argv)
     std::cerr << "Building the initial gtirb representation " << std::flush;
     auto StartBuildZeroIR = std::chrono::high_resolution_clock::now();
     std::string filename = vm["input-file"].as<std::string>();
+    if(Stats::instance().enabled())
+    {
+        boost::system::error_code ec;
+        Stats::instance().value("input_file", filename);
+        Stats::instance().value("input_size", fs::file_size(filename, ec));
+    }
+    Stats::Phase BuildPhase = Stats::instance().phase("build");
     auto GTIRB = GtirbBuilder::read(filename);
     if(!GTIRB)
     {
@@ -195,6 +343,7 @@ int main(int argc, char **argv)
 
     // Add `ddisasmVersion' aux data table.
     GTIRB->IR->addAuxData<gtirb::schema::DdisasmVersion>(DDISASM_FULL_VERSION_STRING);
+    BuildPhase.stop();
     printElapsedTimeSince(StartBuildZeroIR);
 
     if(!GTIRB->IR)
@@ -208,7 +357,17 @@ int main(int argc, char **argv)
     auto StartDecode = std::chrono::high_resolution_clock::now();
 
     gtirb::Module &Module = *(GTIRB->IR->modules().begin());
-    std::optional<DatalogProgram> Souffle = DatalogProgram::load(Module);
+    unsigned int NThreads = vm["threads"].as<unsigned int>();
+    std::optional<std::string> DecodeCache;
+    if(vm.count("decode-cache") != 0)
+    {
+        DecodeCache = vm["decode-cache"].as<std::string>();
+        fs::create_directories(*DecodeCache);
+    }
+    Stats::Phase DecodePhase = Stats::instance().phase("decode");
+    std::optional<DatalogProgram> Souffle =
+        DatalogProgram::load(Module, NThreads, DecodeCache, useLeanProgram(vm));
+    DecodePhase.stop();
 
     printElapsedTimeSince(StartDecode);
 
@@ -225,18 +384,19 @@ int main(int argc, char **argv)
     if(Souffle)
     {
         Souffle->insert("option", createDisasmOptions(vm));
+        Souffle->threads(NThreads);
 
         if(vm.count("debug-dir") != 0)
         {
             std::cerr << "Writing facts to debug dir " << vm["debug-dir"].as<std::string>()
                       << std::endl;
             auto dir = vm["debug-dir"].as<std::string>() + "/";
-            Souffle->writeFacts(dir);
+            Stats::Phase Phase = Stats::instance().phase("write-facts");
+            Souffle->writeFacts(dir, vm.count("binary-facts") != 0);
         }
         std::cerr << "Disassembling" << std::flush;
-        unsigned int NThreads = vm["threads"].as<unsigned int>();
-        Souffle->threads(NThreads);
         auto StartDisassembling = std::chrono::high_resolution_clock::now();
+        Stats::Phase DatalogPhase = Stats::instance().phase("datalog");
         try
         {
             Souffle->run();
@@ -245,17 +405,48 @@ int main(int argc, char **argv)
         {
             souffle::SignalHandler::instance()->error(e.what());
         }
+        DatalogPhase.stop();
         printElapsedTimeSince(StartDisassembling);
+        Stats::instance().relations(Souffle->get());
+
+        // Only keep the relations that are used to build GTIRB. The analysis
+        // is a single Souffle program, so this lowers the memory used while
+        // GTIRB is populated, not the peak memory of the run.
+        bool SelfDiagnose = vm.count("self-diagnose") != 0;
+        if(vm.count("debug-dir") == 0)
+        {
+            Souffle->retain(disassemblyRelations(SelfDiagnose, commentsRequested(vm)));
+        }
+
         std::cerr << "Populating gtirb representation " << std::flush;
         auto StartGtirbBuilding = std::chrono::high_resolution_clock::now();
-        disassembleModule(*GTIRB->Context, Module, Souffle->get(), vm.count("self-diagnose") != 0);
+        Stats::Phase PopulatePhase = Stats::instance().phase("populate");
+        disassembleModule(*GTIRB->Context, Module, Souffle->get(), SelfDiagnose, NThreads,
+                          commentsRequested(vm));
+        PopulatePhase.stop();
         printElapsedTimeSince(StartGtirbBuilding);
 
+        if(vm.count("debug-dir") != 0)
+        {
+            std::cerr << "Writing results to debug dir " << vm["debug-dir"].as<std::string>()
+                      << std::endl;
+            auto dir = vm["debug-dir"].as<std::string>() + "/";
+            Stats::Phase Phase = Stats::instance().phase("write-relations");
+            Souffle->writeRelations(dir);
+        }
+        bool Sane = performSanityChecks(Souffle->get(), SelfDiagnose);
+
+        // The remaining analyses use their own Datalog programs, so release
+        // this one first.
+        Souffle.reset();
+
         if(vm.count("skip-function-analysis") == 0)
         {
             std::cerr << "Computing intra-procedural SCCs " << std::flush;
             auto StartSCCsComputation = std::chrono::high_resolution_clock::now();
+            Stats::Phase SccPhase = Stats::instance().phase("scc");
             computeSCCs(Module);
+            SccPhase.stop();
             printElapsedTimeSince(StartSCCsComputation);
             std::cerr << "Computing no return analysis " << std::flush;
             NoReturnPass NoReturn;
@@ -266,16 +457,21 @@ int main(int argc, char **argv)
                 FunctionInference.setDebugDir(vm["debug-dir"].as<std::string>() + "/");
             }
             auto StartNoReturnAnalysis = std::chrono::high_resolution_clock::now();
+            Stats::Phase NoReturnPhase = Stats::instance().phase("no-return");
             NoReturn.computeNoReturn(Module, NThreads);
+            NoReturnPhase.stop();
             printElapsedTimeSince(StartNoReturnAnalysis);
             std::cerr << "Detecting additional functions " << std::flush;
             auto StartFunctionAnalysis = std::chrono::high_resolution_clock::now();
+            Stats::Phase FunctionPhase = Stats::instance().phase("function-inference");
             FunctionInference.computeFunctions(*GTIRB->Context, Module, NThreads);
+            FunctionPhase.stop();
             printElapsedTimeSince(StartFunctionAnalysis);
         }
         // Output GTIRB
         if(vm.count("ir") != 0)
         {
+            Stats::Phase Phase = Stats::instance().phase("output-ir");
             std::string name = vm["ir"].as<std::string>();
             if(name == "-")
             {
@@ -291,6 +487,7 @@ int main(int argc, char **argv)
         // Output json GTIRB
         if(vm.count("json") != 0)
         {
+            Stats::Phase Phase = Stats::instance().phase("output-json");
             std::string name = vm["json"].as<std::string>();
             if(name == "-")
             {
@@ -317,6 +514,7 @@ int main(int argc, char **argv)
         {
             std::cerr << "Printing assembler " << std::flush;
             auto StartPrinting = std::chrono::high_resolution_clock::now();
+            Stats::Phase Phase = Stats::instance().phase("output-asm");
             std::string name = vm["asm"].as<std::string>();
             if(name == "-")
             {
@@ -327,22 +525,22 @@ int main(int argc, char **argv)
                 std::ofstream out(name);
                 pprinter.print(out, *GTIRB->Context, Module);
             }
+            Phase.stop();
             printElapsedTimeSince(StartPrinting);
         }
         else if(vm.count("ir") == 0 && vm.count("json") == 0)
         {
             std::cerr << "Printing assembler" << std::endl;
+            Stats::Phase Phase = Stats::instance().phase("output-asm");
             pprinter.print(std::cout, *GTIRB->Context, Module);
         }
-
-        if(vm.count("debug-dir") != 0)
+        writeStats(vm);
+        setProfileLog(vm);
+        if(!Sane)
         {
-            std::cerr << "Writing results to debug dir " << vm["debug-dir"].as<std::string>()
-                      << std::endl;
-            auto dir = vm["debug-dir"].as<std::string>() + "/";
-            Souffle->writeRelations(dir);
+            std::cerr << "Aborting" << std::endl;
+            return 1;
         }
-        performSanityChecks(Souffle->get(), vm.count("self-diagnose") != 0);
     }
     else
     {
@@ -0,0 +1,79 @@
+//===- ModuleIndex.cpp ------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include "ModuleIndex.h"
+
+ModuleIndex::ModuleIndex(gtirb::Module &M) : Module(M)
+{
+    for(gtirb::ByteInterval &ByteInterval : Module.byte_intervals())
+    {
+        if(std::optional<gtirb::Addr> Addr = ByteInterval.getAddress())
+        {
+            ByteIntervals.add(*Addr, ByteInterval.getSize(), &ByteInterval);
+        }
+    }
+    ByteIntervals.sort();
+    indexSymbols();
+}
+
+void ModuleIndex::indexBlocks()
+{
+    CodeBlocks.clear();
+    for(gtirb::CodeBlock &Block : Module.code_blocks())
+    {
+        if(std::optional<gtirb::Addr> Addr = Block.getAddress())
+        {
+            CodeBlocks.add(*Addr, Block.getSize(), &Block);
+        }
+    }
+    CodeBlocks.sort();
+
+    DataBlocks.clear();
+    for(gtirb::DataBlock &Block : Module.data_blocks())
+    {
+        if(std::optional<gtirb::Addr> Addr = Block.getAddress())
+        {
+            DataBlocks.add(*Addr, Block.getSize(), &Block);
+        }
+    }
+    DataBlocks.sort();
+}
+
+void ModuleIndex::indexSymbols()
+{
+    Symbols.clear();
+    for(gtirb::Symbol &Symbol : Module.symbols_by_addr())
+    {
+        if(std::optional<gtirb::Addr> Addr = Symbol.getAddress())
+        {
+            Symbols.emplace_hint(Symbols.end(), *Addr, &Symbol);
+        }
+    }
+}
+
+gtirb::Symbol *ModuleIndex::addSymbol(gtirb::Context &Context, gtirb::Addr A,
+                                      const std::string &Name)
+{
+    gtirb::Symbol *Symbol = Module.addSymbol(Context, A, Name);
+    Symbols.emplace(A, Symbol);
+    return Symbol;
+}
@@ -0,0 +1,184 @@
+//===- ModuleIndex.h --------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_MODULE_INDEX_H_
+#define SRC_MODULE_INDEX_H_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtirb/gtirb.hpp>
+
+// Sorted table of the address ranges of GTIRB nodes. Overlapping ranges are
+// allowed; the running maximum of the range ends bounds the backward scan of
+// a query, which stays short when ranges rarely overlap.
+template <typename T>
+class AddressRanges
+{
+public:
+    void clear()
+    {
+        Entries.clear();
+        MaxEnd.clear();
+    }
+
+    void add(gtirb::Addr Begin, uint64_t Size, T *Node)
+    {
+        Entries.push_back({Begin, Begin + Size, Node});
+    }
+
+    // Sort the ranges after adding them.
+    void sort()
+    {
+        std::stable_sort(Entries.begin(), Entries.end(),
+                         [](const Entry &A, const Entry &B) { return A.Begin < B.Begin; });
+        MaxEnd.resize(Entries.size());
+        for(size_t I = 0; I < Entries.size(); I++)
+        {
+            MaxEnd[I] = I > 0 ? std::max(MaxEnd[I - 1], Entries[I].End) : Entries[I].End;
+        }
+    }
+
+    // Nodes whose range contains `A', in address order.
+    std::vector<T *> on(gtirb::Addr A) const
+    {
+        std::vector<T *> Nodes;
+        size_t I = upperBound(A);
+        while(I > 0 && MaxEnd[I - 1] > A)
+        {
+            --I;
+            if(Entries[I].End > A)
+            {
+                Nodes.push_back(Entries[I].Node);
+            }
+        }
+        std::reverse(Nodes.begin(), Nodes.end());
+        return Nodes;
+    }
+
+    // First node, in address order, whose range contains `A'.
+    T *firstOn(gtirb::Addr A) const
+    {
+        T *Node = nullptr;
+        size_t I = upperBound(A);
+        while(I > 0 && MaxEnd[I - 1] > A)
+        {
+            --I;
+            if(Entries[I].End > A)
+            {
+                Node = Entries[I].Node;
+            }
+        }
+        return Node;
+    }
+
+    // First node that starts at `A'.
+    T *at(gtirb::Addr A) const
+    {
+        auto It = std::lower_bound(Entries.begin(), Entries.end(), A,
+                                   [](const Entry &E, gtirb::Addr X) { return E.Begin < X; });
+        return It != Entries.end() && It->Begin == A ? It->Node : nullptr;
+    }
+
+private:
+    struct Entry
+    {
+        gtirb::Addr Begin;
+        gtirb::Addr End;
+        T *Node;
+    };
+
+    size_t upperBound(gtirb::Addr A) const
+    {
+        auto It = std::upper_bound(Entries.begin(), Entries.end(), A,
+                                   [](gtirb::Addr X, const Entry &E) { return X < E.Begin; });
+        return static_cast<size_t>(It - Entries.begin());
+    }
+
+    std::vector<Entry> Entries;
+    std::vector<gtirb::Addr> MaxEnd;
+};
+
+// Address index of the byte intervals, blocks and symbols of a module, built
+// once for the population of the module from the Datalog results instead of
+// querying the module for every tuple.
+class ModuleIndex
+{
+public:
+    using SymbolRange = std::pair<std::multimap<gtirb::Addr, gtirb::Symbol *>::const_iterator,
+                                  std::multimap<gtirb::Addr, gtirb::Symbol *>::const_iterator>;
+
+    explicit ModuleIndex(gtirb::Module &M);
+
+    // Index the blocks of the module. Call again after adding blocks.
+    void indexBlocks();
+
+    // Index the symbols of the module. Call again after symbols are moved to
+    // another address, e.g. by changing their referent.
+    void indexSymbols();
+
+    gtirb::ByteInterval *byteIntervalOn(gtirb::Addr A) const
+    {
+        return ByteIntervals.firstOn(A);
+    }
+
+    gtirb::CodeBlock *codeBlockOn(gtirb::Addr A) const
+    {
+        return CodeBlocks.firstOn(A);
+    }
+
+    gtirb::CodeBlock *codeBlockAt(gtirb::Addr A) const
+    {
+        return CodeBlocks.at(A);
+    }
+
+    std::vector<gtirb::CodeBlock *> codeBlocksOn(gtirb::Addr A) const
+    {
+        return CodeBlocks.on(A);
+    }
+
+    std::vector<gtirb::DataBlock *> dataBlocksOn(gtirb::Addr A) const
+    {
+        return DataBlocks.on(A);
+    }
+
+    // Symbols at address `A', in the order of the module's symbol index.
+    SymbolRange symbols(gtirb::Addr A) const
+    {
+        return Symbols.equal_range(A);
+    }
+
+    // Add a symbol at an address to the module and to the index.
+    gtirb::Symbol *addSymbol(gtirb::Context &Context, gtirb::Addr A, const std::string &Name);
+
+private:
+    gtirb::Module &Module;
+    AddressRanges<gtirb::ByteInterval> ByteIntervals;
+    AddressRanges<gtirb::CodeBlock> CodeBlocks;
+    AddressRanges<gtirb::DataBlock> DataBlocks;
+    std::multimap<gtirb::Addr, gtirb::Symbol *> Symbols;
+};
+
+#endif // SRC_MODULE_INDEX_H_
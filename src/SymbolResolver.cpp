@@ -0,0 +1,62 @@
+//===- SymbolResolver.cpp ---------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include "SymbolResolver.h"
+
+#include <sstream>
+
+std::string getLabel(uint64_t ea)
+{
+    std::stringstream ss;
+    ss << ".L_" << std::hex << ea;
+    return ss.str();
+}
+
+gtirb::Symbol *SymbolResolver::resolve(gtirb::Addr ea)
+{
+    const auto *symbolForwarding = forwarding();
+    if(auto [begin, end] = Index.symbols(ea); begin != end)
+    {
+        gtirb::Symbol *bestSymbol = begin->second;
+        for(auto it = begin; it != end; it++)
+        {
+            auto forwardSymbol = symbolForwarding->find(it->second->getUUID());
+            if(forwardSymbol != symbolForwarding->end())
+                bestSymbol = it->second;
+        }
+        return bestSymbol;
+    }
+
+    gtirb::Symbol *symbol = Index.addSymbol(Context, ea, getLabel(uint64_t(ea)));
+
+    if(!SymbolInfo)
+    {
+        SymbolInfo = Module.getAuxData<gtirb::schema::ElfSymbolInfoAD>();
+    }
+    if(SymbolInfo)
+    {
+        ElfSymbolInfo Info = {0, "NONE", "LOCAL", "DEFAULT", 0};
+        SymbolInfo->insert({symbol->getUUID(), Info});
+    }
+
+    return symbol;
+}
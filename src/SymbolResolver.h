@@ -0,0 +1,92 @@
+//===- SymbolResolver.h -----------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_SYMBOL_RESOLVER_H_
+#define SRC_SYMBOL_RESOLVER_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <gtirb/gtirb.hpp>
+
+#include "AuxDataSchema.h"
+#include "ModuleIndex.h"
+
+// Name of the label created for an address without symbols.
+std::string getLabel(uint64_t ea);
+
+// Resolve addresses to the symbol that symbolic expressions refer to, creating
+// `.L_' labels for addresses without symbols. Resolved symbols are cached for
+// the whole population of a module, since the same jump table targets and
+// globals are referenced again and again.
+class SymbolResolver
+{
+public:
+    SymbolResolver(gtirb::Context &context, gtirb::Module &module, ModuleIndex &index)
+        : Context(context), Module(module), Index(index)
+    {
+    }
+
+    gtirb::Symbol *get(gtirb::Addr ea)
+    {
+        auto [it, inserted] = Cache.try_emplace(static_cast<uint64_t>(ea), nullptr);
+        if(inserted)
+        {
+            it->second = resolve(ea);
+        }
+        return it->second;
+    }
+
+    // Forward a symbol to another one in the SymbolForwarding table.
+    void forward(const gtirb::Symbol &src, const gtirb::Symbol &dest)
+    {
+        (*forwarding())[src.getUUID()] = dest.getUUID();
+        // Forwarded symbols are preferred, so the symbol of the address may change.
+        if(std::optional<gtirb::Addr> ea = src.getAddress())
+        {
+            Cache.erase(static_cast<uint64_t>(*ea));
+        }
+    }
+
+private:
+    gtirb::schema::SymbolForwarding::Type *forwarding()
+    {
+        if(!SymbolForwarding)
+        {
+            SymbolForwarding = Module.getAuxData<gtirb::schema::SymbolForwarding>();
+        }
+        return SymbolForwarding;
+    }
+
+    gtirb::Symbol *resolve(gtirb::Addr ea);
+
+    gtirb::Context &Context;
+    gtirb::Module &Module;
+    ModuleIndex &Index;
+    gtirb::schema::SymbolForwarding::Type *SymbolForwarding = nullptr;
+    gtirb::schema::ElfSymbolInfoAD::Type *SymbolInfo = nullptr;
+    std::unordered_map<uint64_t, gtirb::Symbol *> Cache;
+};
+
+#endif // SRC_SYMBOL_RESOLVER_H_
@@ -0,0 +1,89 @@
+//===- UUIDGenerator.h ------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_UUID_GENERATOR_H_
+#define SRC_UUID_GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include <boost/uuid/detail/sha1.hpp>
+#include <gtirb/gtirb.hpp>
+
+// Fast source of deterministic UUIDs for the nodes of a module that ddisasm
+// identifies by address (e.g. functions). The UUIDs only depend on the name
+// and ISA of the module, the kind of node and its address, so the same binary
+// gets the same identifiers in every run. This only covers the UUIDs that
+// ddisasm generates itself: GTIRB assigns random UUIDs to the nodes it creates
+// (blocks, symbols, ...), and its API does not let callers supply them.
+class UUIDGenerator
+{
+public:
+    UUIDGenerator(const gtirb::Module& Module, const std::string& Kind)
+    {
+        std::string Name = Module.getName();
+        uint64_t ISA = static_cast<uint64_t>(Module.getISA());
+
+        boost::uuids::detail::sha1 Hash;
+        Hash.process_bytes(Name.data(), Name.size() + 1);
+        Hash.process_bytes(&ISA, sizeof(ISA));
+        Hash.process_bytes(Kind.data(), Kind.size() + 1);
+
+        boost::uuids::detail::sha1::digest_type Digest;
+        Hash.get_digest(Digest);
+        for(auto Word : Digest)
+        {
+            Seed = mix(Seed ^ static_cast<uint64_t>(Word));
+        }
+    }
+
+    // UUID of the node at address A.
+    gtirb::UUID operator()(gtirb::Addr A) const
+    {
+        uint64_t High = mix(Seed ^ static_cast<uint64_t>(A));
+        uint64_t Low = mix(High ^ ~Seed);
+        gtirb::UUID UUID;
+        for(int I = 0; I < 8; I++)
+        {
+            UUID.data[I] = static_cast<uint8_t>(High >> (56 - 8 * I));
+            UUID.data[8 + I] = static_cast<uint8_t>(Low >> (56 - 8 * I));
+        }
+        // Set the version and variant bits of a custom (version 8) UUID, as
+        // the bits are not derived with any of the standard algorithms.
+        UUID.data[6] = (UUID.data[6] & 0x0F) | 0x80;
+        UUID.data[8] = (UUID.data[8] & 0x3F) | 0x80;
+        return UUID;
+    }
+
+private:
+    // Finalizer of splitmix64, a bijection with good avalanche.
+    static uint64_t mix(uint64_t X)
+    {
+        X = (X ^ (X >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        X = (X ^ (X >> 27)) * 0x94d049bb133111ebULL;
+        return X ^ (X >> 31);
+    }
+
+    uint64_t Seed = 0;
+};
+
+#endif // SRC_UUID_GENERATOR_H_
@@ -0,0 +1,184 @@
+//===- DecodeBenchmark.cpp --------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <capstone/capstone.h>
+#include <gtirb/gtirb.hpp>
+
+#include "../Registration.h"
+#include "../gtirb-builder/GtirbBuilder.h"
+#include "../gtirb-decoder/arch/Arm64Loader.h"
+#include "../gtirb-decoder/arch/X64Loader.h"
+
+// Measure superset decoding throughput (decoded bytes per second) of the
+// executable sections of the given binaries.
+
+using Clock = std::chrono::high_resolution_clock;
+
+template <typename T>
+class BenchmarkLoader : public T
+{
+public:
+    typename T::FactsType facts(const gtirb::Module& Module)
+    {
+        typename T::FactsType Facts;
+        this->load(Module, Facts);
+        return Facts;
+    }
+};
+
+// Decode with one heap-allocated instruction per offset (cs_disasm/cs_free).
+static uint64_t decodeAllocating(csh Handle, const uint8_t* Data, uint64_t Size, uint64_t Addr,
+                                 uint64_t Step)
+{
+    uint64_t Count = 0;
+    for(uint64_t Offset = 0; Offset < Size; Offset += Step)
+    {
+        cs_insn* Insn;
+        size_t N = cs_disasm(Handle, Data + Offset, Size - Offset, Addr + Offset, 1, &Insn);
+        Count += N;
+        cs_free(Insn, N);
+    }
+    return Count;
+}
+
+// Decode into a single preallocated instruction (cs_malloc/cs_disasm_iter).
+static uint64_t decodeIterating(csh Handle, const uint8_t* Data, uint64_t Size, uint64_t Addr,
+                                uint64_t Step)
+{
+    uint64_t Count = 0;
+    cs_insn* Insn = cs_malloc(Handle);
+    for(uint64_t Offset = 0; Offset < Size; Offset += Step)
+    {
+        const uint8_t* Code = Data + Offset;
+        size_t CodeSize = Size - Offset;
+        uint64_t Address = Addr + Offset;
+        Count += cs_disasm_iter(Handle, &Code, &CodeSize, &Address, Insn) ? 1 : 0;
+    }
+    cs_free(Insn, 1);
+    return Count;
+}
+
+template <typename F>
+static void report(const std::string& Name, uint64_t Bytes, F Fn)
+{
+    auto Start = Clock::now();
+    Fn();
+    std::chrono::duration<double> Elapsed = Clock::now() - Start;
+    double Rate = Elapsed.count() > 0 ? Bytes / Elapsed.count() / (1024 * 1024) : 0;
+    std::cout << "  " << std::left << std::setw(16) << Name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << Elapsed.count() << " s "
+              << std::setprecision(2) << std::setw(10) << Rate << " MiB/s\n";
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " BINARY...\n";
+        return 1;
+    }
+
+    registerAuxDataTypes();
+
+    for(int I = 1; I < argc; I++)
+    {
+        auto GTIRB = GtirbBuilder::read(argv[I]);
+        if(!GTIRB)
+        {
+            std::cerr << "ERROR: " << argv[I] << ": " << GTIRB.getError().message() << "\n";
+            continue;
+        }
+        gtirb::Module& Module = *(GTIRB->IR->modules().begin());
+
+        bool Arm64 = Module.getISA() == gtirb::ISA::ARM64;
+        uint64_t Step = Arm64 ? 4 : 1;
+
+        csh Handle;
+        if(Arm64)
+        {
+            cs_open(CS_ARCH_ARM64, CS_MODE_ARM, &Handle);
+        }
+        else
+        {
+            cs_open(CS_ARCH_X86, CS_MODE_64, &Handle);
+        }
+        cs_option(Handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+        uint64_t Bytes = 0;
+        for(const auto& Section : Module.sections())
+        {
+            if(Section.isFlagSet(gtirb::SectionFlag::Executable))
+            {
+                for(const auto& ByteInterval : Section.byte_intervals())
+                {
+                    Bytes += ByteInterval.getInitializedSize();
+                }
+            }
+        }
+
+        auto forEachInterval = [&](auto Fn) {
+            for(const auto& Section : Module.sections())
+            {
+                if(Section.isFlagSet(gtirb::SectionFlag::Executable))
+                {
+                    for(const auto& ByteInterval : Section.byte_intervals())
+                    {
+                        Fn(ByteInterval.rawBytes<const uint8_t>(),
+                           ByteInterval.getInitializedSize(),
+                           static_cast<uint64_t>(*ByteInterval.getAddress()));
+                    }
+                }
+            }
+        };
+
+        std::cout << argv[I] << " (" << Bytes << " executable bytes)\n";
+        report("cs_disasm", Bytes, [&]() {
+            forEachInterval([&](const uint8_t* Data, uint64_t Size, uint64_t Addr) {
+                decodeAllocating(Handle, Data, Size, Addr, Step);
+            });
+        });
+        report("cs_disasm_iter", Bytes, [&]() {
+            forEachInterval([&](const uint8_t* Data, uint64_t Size, uint64_t Addr) {
+                decodeIterating(Handle, Data, Size, Addr, Step);
+            });
+        });
+        report("loader", Bytes, [&]() {
+            if(Arm64)
+            {
+                BenchmarkLoader<Arm64Loader>().facts(Module);
+            }
+            else
+            {
+                BenchmarkLoader<X64Loader>().facts(Module);
+            }
+        });
+
+        cs_close(&Handle);
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+//===- PointerScanBenchmark.cpp ---------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtirb/gtirb.hpp>
+
+#include "../Registration.h"
+#include "../gtirb-builder/GtirbBuilder.h"
+#include "../gtirb-decoder/core/PointerScanner.h"
+
+// Measure the throughput of the `address_in_data' candidate scan over the
+// loaded sections of the given binaries, comparing the byte-at-a-time check
+// against the module span with the scanner kernels.
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Interval
+{
+    const uint8_t* Data;
+    uint64_t Size;
+};
+
+// Check every offset against the [Min, Max] span of the module.
+static uint64_t scanSpan(const Interval& I, uint64_t PointerSize, uint64_t Min, uint64_t Max)
+{
+    uint64_t Count = 0;
+    for(uint64_t Offset = 0; Offset + PointerSize <= I.Size; Offset++)
+    {
+        uint64_t Value = PointerSize == 4
+                             ? static_cast<uint64_t>(*((int32_t*)(I.Data + Offset)))
+                             : *((uint64_t*)(I.Data + Offset));
+        if(Value >= Min && Value <= Max)
+        {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+template <typename F>
+static void report(const std::string& Name, uint64_t Bytes, F Fn)
+{
+    auto Start = Clock::now();
+    uint64_t Count = Fn();
+    std::chrono::duration<double> Elapsed = Clock::now() - Start;
+    double Rate = Elapsed.count() > 0 ? Bytes / Elapsed.count() / (1024 * 1024) : 0;
+    std::cout << "  " << std::left << std::setw(16) << Name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << Elapsed.count() << " s "
+              << std::setprecision(2) << std::setw(10) << Rate << " MiB/s " << std::setw(10)
+              << Count << " candidates\n";
+}
+
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " BINARY...\n";
+        return 1;
+    }
+
+    registerAuxDataTypes();
+
+    for(int I = 1; I < argc; I++)
+    {
+        auto GTIRB = GtirbBuilder::read(argv[I]);
+        if(!GTIRB)
+        {
+            std::cerr << "ERROR: " << argv[I] << ": " << GTIRB.getError().message() << "\n";
+            continue;
+        }
+        gtirb::Module& Module = *(GTIRB->IR->modules().begin());
+
+        uint64_t PointerSize = Module.getISA() == gtirb::ISA::IA32 ? 4 : 8;
+        uint64_t Min = static_cast<uint64_t>(*Module.getAddress());
+        uint64_t Max = Min + *Module.getSize();
+
+        std::vector<PointerScanner::Range> Ranges;
+        std::vector<Interval> Intervals;
+        uint64_t Bytes = 0;
+        for(const auto& Section : Module.sections())
+        {
+            if(Section.getAddress() && Section.getSize())
+            {
+                uint64_t Begin = static_cast<uint64_t>(*Section.getAddress());
+                Ranges.emplace_back(Begin, Begin + *Section.getSize());
+            }
+            if(Section.isFlagSet(gtirb::SectionFlag::Executable)
+               || Section.isFlagSet(gtirb::SectionFlag::Initialized))
+            {
+                for(const auto& ByteInterval : Section.byte_intervals())
+                {
+                    Intervals.push_back({ByteInterval.rawBytes<const uint8_t>(),
+                                         ByteInterval.getInitializedSize()});
+                    Bytes += ByteInterval.getInitializedSize();
+                }
+            }
+        }
+
+        std::cout << argv[I] << " (" << Bytes << " loaded bytes)\n";
+        report("span", Bytes, [&]() {
+            uint64_t Count = 0;
+            for(const Interval& Interval : Intervals)
+            {
+                Count += scanSpan(Interval, PointerSize, Min, Max);
+            }
+            return Count;
+        });
+
+        PointerScanner Scanner(PointerSize, Ranges);
+        for(auto [Name, Kernel] : {std::make_pair("scalar", PointerScanner::Kernel::Scalar),
+                                   std::make_pair("sse2", PointerScanner::Kernel::SSE2),
+                                   std::make_pair("avx2", PointerScanner::Kernel::AVX2)})
+        {
+            Scanner.kernel(Kernel);
+            if(Scanner.kernel() != Kernel)
+            {
+                std::cout << "  " << Name << " (unsupported)\n";
+                continue;
+            }
+            report(Name, Bytes, [&]() {
+                std::vector<uint64_t> Offsets;
+                for(const Interval& Interval : Intervals)
+                {
+                    Scanner.scan(Interval.Data, Interval.Size, Offsets);
+                }
+                return static_cast<uint64_t>(Offsets.size());
+            });
+        }
+    }
+
+    return 0;
+}
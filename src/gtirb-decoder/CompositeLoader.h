@@ -23,14 +23,22 @@
 #ifndef SRC_GTIRB_DECODER_COMPOSITELOADER_H_
 #define SRC_GTIRB_DECODER_COMPOSITELOADER_H_
 
+#include <algorithm>
+#include <iterator>
 #include <optional>
+#include <set>
 #include <string>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+#include <boost/core/demangle.hpp>
 #include <gtirb/gtirb.hpp>
 
 #include "DatalogProgram.h"
+#include "Parallel.h"
 #include "Relations.h"
+#include "Stats.h"
 
 class CompositeLoader
 {
@@ -41,27 +49,66 @@ public:
     // Common type definition for functions/functors that populate datalog relations.
     using Loader = std::function<void(const gtirb::Module&, DatalogProgram&)>;
 
-    // Add function to this composite loader.
+    // Add function to this composite loader. The name of a loader identifies
+    // it in the --stats-json report.
+    void add(const std::string& LoaderName, Loader Fn)
+    {
+        Loaders.push_back({LoaderName, Fn, std::nullopt});
+    }
+
+    // Add function that only writes the `Writes' relations. Consecutive
+    // loaders that declare disjoint relations run concurrently when the
+    // program has more than one thread.
+    void add(const std::string& LoaderName, Loader Fn, std::set<std::string> Writes)
+    {
+        Loaders.push_back({LoaderName, Fn, std::move(Writes)});
+    }
+
     void add(Loader Fn)
     {
-        Loaders.push_back(Fn);
+        add("loader" + std::to_string(Loaders.size()), Fn);
     }
 
     // Add function object to this composite loader.
     template <typename T, typename... Args>
     void add(Args&&... A)
     {
-        Loaders.push_back(T{std::forward<Args>(A)...});
+        add(boost::core::demangle(typeid(T).name()), T{std::forward<Args>(A)...});
+    }
+
+    // Build a DatalogProgram (i.e. SouffleProgram). Loaders may use up to
+    // `NThreads` threads, which is also the thread count of the program, and
+    // reuse decoded instructions from the `DecodeCache` directory.
+    std::optional<DatalogProgram> load(const gtirb::Module& Module, unsigned int NThreads = 1,
+                                       const std::optional<std::string>& DecodeCache = std::nullopt,
+                                       bool Lean = false)
+    {
+        if(std::optional<DatalogProgram> Program = program(NThreads, Lean))
+        {
+            Program->decodeCache(DecodeCache);
+            return operator()(Module, *Program);
+        }
+        return std::nullopt;
     }
 
-    // Build a DatalogProgram (i.e. SouffleProgram).
-    std::optional<DatalogProgram> load(const gtirb::Module& Module)
+    // Build an empty DatalogProgram, without running the loaders. A `Lean`
+    // program is the `<name>_lean` variant of the program, if there is one.
+    std::optional<DatalogProgram> program(unsigned int NThreads = 1, bool Lean = false) const
     {
-        if(auto SouffleProgram =
-               std::shared_ptr<souffle::SouffleProgram>(souffle::ProgramFactory::newInstance(Name)))
+        souffle::SouffleProgram* Instance = nullptr;
+        if(Lean)
+        {
+            Instance = souffle::ProgramFactory::newInstance(Name + "_lean");
+        }
+        if(!Instance)
+        {
+            Instance = souffle::ProgramFactory::newInstance(Name);
+        }
+        if(auto SouffleProgram = std::shared_ptr<souffle::SouffleProgram>(Instance))
         {
             DatalogProgram Program{SouffleProgram};
-            return operator()(Module, Program);
+            Program.threads(NThreads);
+            return Program;
         }
         return std::nullopt;
     }
@@ -69,16 +116,60 @@ public:
     // Implement loader interface for composition of CompositeLoaders.
     std::optional<DatalogProgram> operator()(const gtirb::Module& Module, DatalogProgram& Program)
     {
-        for(auto& Loader : Loaders)
+        auto Run = [&](const Entry& E, bool MeasureCpu) {
+            Stats::Phase Phase = Stats::instance().phase(Name + "/" + E.Name, MeasureCpu);
+            E.Fn(Module, Program);
+        };
+        for(auto It = Loaders.begin(); It != Loaders.end();)
         {
-            Loader(Module, Program);
+            // Group the following loaders that write disjoint relations.
+            auto End = std::next(It);
+            if(Program.threads() > 1 && It->Writes)
+            {
+                std::set<std::string> Written = *It->Writes;
+                for(; End != Loaders.end() && End->Writes; ++End)
+                {
+                    if(std::any_of(End->Writes->begin(), End->Writes->end(),
+                                   [&](const std::string& R) { return Written.count(R) > 0; }))
+                    {
+                        break;
+                    }
+                    Written.insert(End->Writes->begin(), End->Writes->end());
+                }
+            }
+            size_t N = std::distance(It, End);
+            if(N == 1)
+            {
+                Run(*It, true);
+            }
+            else
+            {
+                // The process CPU time spent by concurrent loaders includes
+                // that of their siblings, so it is only measured for the group.
+                std::string Group;
+                for(auto G = It; G != End; ++G)
+                {
+                    Group += (G == It ? "" : "+") + G->Name;
+                }
+                Stats::Phase Phase = Stats::instance().phase(Name + "/" + Group);
+                parallelFor(N, N, [&](size_t I) { Run(*std::next(It, I), false); });
+            }
+            It = End;
         }
         return Program;
     }
 
 private:
+    struct Entry
+    {
+        std::string Name;
+        Loader Fn;
+        // Relations written by the loader, if it declares them.
+        std::optional<std::set<std::string>> Writes;
+    };
+
     std::string Name;
-    std::vector<Loader> Loaders;
+    std::vector<Entry> Loaders;
 };
 
 #endif // SRC_GTIRB_DECODER_COMPOSITELOADER_H_
@@ -20,12 +20,22 @@
 //  endorsement should be inferred.
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
 
 #include <gtirb/gtirb.hpp>
 
 #include "CompositeLoader.h"
 #include "DatalogProgram.h"
+#include "Parallel.h"
+#include "core/ModuleLoader.h"
 
 std::map<DatalogProgram::Target, DatalogProgram::Factory> &DatalogProgram::loaders()
 {
@@ -33,39 +43,488 @@ std::map<DatalogProgram::Target, DatalogProgram::Factory> &DatalogProgram::loade
     return Loaders;
 }
 
-std::optional<DatalogProgram> DatalogProgram::load(const gtirb::Module &Module)
+void DatalogProgram::insertRows(souffle::Relation *Relation, std::vector<souffle::RamDomain> &Rows,
+                                bool Interned)
+{
+    size_t Arity = Relation->getArity();
+    if(Arity == 0 || Rows.empty())
+    {
+        return;
+    }
+    size_t Count = Rows.size() / Arity;
+
+    if(Interned)
+    {
+        std::vector<size_t> Columns;
+        for(size_t I = 0; I < Arity; I++)
+        {
+            if(*Relation->getAttrType(I) == 's')
+            {
+                Columns.push_back(I);
+            }
+        }
+        // Only look up the names that are used by some row, resolving them
+        // all at once.
+        std::vector<relations::NameId> Used;
+        std::vector<souffle::RamDomain> Ids;
+        for(size_t Row = 0; Row < Count; Row++)
+        {
+            for(size_t Column : Columns)
+            {
+                size_t Value = static_cast<size_t>(Rows[Row * Arity + Column]);
+                if(Value >= Ids.size())
+                {
+                    Ids.resize(Value + 1, -1);
+                }
+                if(Ids[Value] == -1)
+                {
+                    Ids[Value] = 0;
+                    Used.push_back(relations::NameId{static_cast<uint32_t>(Value)});
+                }
+            }
+        }
+        std::vector<std::string_view> Names = relations::resolve(Used);
+        souffle::SymbolTable &SymbolTable = Relation->getSymbolTable();
+        for(size_t I = 0; I < Used.size(); I++)
+        {
+            Ids[Used[I].Id] = SymbolTable.lookup(std::string(Names[I]));
+        }
+        for(size_t Row = 0; Row < Count; Row++)
+        {
+            for(size_t Column : Columns)
+            {
+                souffle::RamDomain &Value = Rows[Row * Arity + Column];
+                Value = Ids[static_cast<size_t>(Value)];
+            }
+        }
+    }
+
+    std::vector<size_t> Order(Count);
+    std::iota(Order.begin(), Order.end(), 0);
+    std::sort(Order.begin(), Order.end(), [&](size_t A, size_t B) {
+        return std::lexicographical_compare(&Rows[A * Arity], &Rows[A * Arity] + Arity,
+                                            &Rows[B * Arity], &Rows[B * Arity] + Arity);
+    });
+
+    souffle::tuple Tuple(Relation);
+    for(size_t Row : Order)
+    {
+        for(size_t I = 0; I < Arity; I++)
+        {
+            Tuple[I] = Rows[Row * Arity + I];
+        }
+        Relation->insert(Tuple);
+    }
+}
+
+std::optional<DatalogProgram> DatalogProgram::load(const gtirb::Module &Module,
+                                                   unsigned int NThreads,
+                                                   const std::optional<std::string> &DecodeCache,
+                                                   bool Lean)
 {
     auto Target = std::make_tuple(Module.getFileFormat(), Module.getISA());
     auto Loader = loaders().at(Target)();
-    return Loader.load(Module);
+    return Loader.load(Module, NThreads, DecodeCache, Lean);
 }
 
-void DatalogProgram::writeFacts(const std::string &Directory)
+namespace
 {
-    std::ios_base::openmode FileMask = std::ios::out;
-    for(souffle::Relation *Relation : Program->getInputRelations())
+    // Magic number of binary facts files ("DDF1").
+    constexpr uint32_t BinaryFactsMagic = 0x44444631;
+
+    std::vector<bool> symbolAttributes(const souffle::Relation &Relation)
     {
-        std::ofstream File(Directory + Relation->getName() + ".facts", FileMask);
-        souffle::SymbolTable SymbolTable = Relation->getSymbolTable();
-        for(souffle::tuple Tuple : *Relation)
+        std::vector<bool> Symbols(Relation.getArity());
+        for(size_t I = 0; I < Symbols.size(); I++)
         {
-            for(size_t I = 0; I < Tuple.size(); I++)
+            Symbols[I] = Relation.getAttrType(I)[0] == 's';
+        }
+        return Symbols;
+    }
+
+    // Write the tuples of a relation as tab-separated lines, as Souffle does
+    // for `.output' relations. Lines are accumulated in a buffer that is
+    // written out in large blocks.
+    void writeRelation(const souffle::Relation &Relation, const std::string &Path)
+    {
+        constexpr size_t BufferSize = 1 << 20;
+
+        std::ofstream File(Path, std::ios::out | std::ios::binary);
+        const souffle::SymbolTable &SymbolTable = Relation.getSymbolTable();
+        std::vector<bool> Symbols = symbolAttributes(Relation);
+
+        std::string Buffer;
+        Buffer.reserve(BufferSize + 4096);
+        for(souffle::tuple Tuple : Relation)
+        {
+            if(Symbols.empty())
+            {
+                Buffer += "()";
+            }
+            for(size_t I = 0; I < Symbols.size(); I++)
             {
                 if(I > 0)
                 {
-                    File << "\t";
+                    Buffer += '\t';
+                }
+                if(Symbols[I])
+                {
+                    Buffer += SymbolTable.resolve(Tuple[I]);
+                }
+                else
+                {
+                    char Number[32];
+                    auto [End, Error] = std::to_chars(Number, Number + sizeof(Number), Tuple[I]);
+                    Buffer.append(Number, End);
+                }
+            }
+            Buffer += '\n';
+            if(Buffer.size() >= BufferSize)
+            {
+                File.write(Buffer.data(), Buffer.size());
+                Buffer.clear();
+            }
+        }
+        File.write(Buffer.data(), Buffer.size());
+    }
+
+    template <typename T>
+    void append(std::string &Buffer, T Value)
+    {
+        Buffer.append(reinterpret_cast<const char *>(&Value), sizeof(Value));
+    }
+
+    // Write the tuples of a relation in binary form:
+    //
+    //   magic, arity, attribute type characters,
+    //   number of strings, (length, characters) for each string,
+    //   number of tuples, values of each tuple.
+    //
+    // Symbols are written as indices into the string table of the file, so
+    // that every distinct string is only stored once.
+    void writeBinaryRelation(const souffle::Relation &Relation, const std::string &Path)
+    {
+        const souffle::SymbolTable &SymbolTable = Relation.getSymbolTable();
+        std::vector<bool> Symbols = symbolAttributes(Relation);
+
+        std::unordered_map<souffle::RamDomain, uint64_t> Indices;
+        std::string Strings, Tuples;
+        for(souffle::tuple Tuple : Relation)
+        {
+            for(size_t I = 0; I < Symbols.size(); I++)
+            {
+                souffle::RamDomain Value = Tuple[I];
+                if(Symbols[I])
+                {
+                    auto [It, Inserted] = Indices.try_emplace(Value, Indices.size());
+                    if(Inserted)
+                    {
+                        const std::string &S = SymbolTable.resolve(Value);
+                        append(Strings, static_cast<uint32_t>(S.size()));
+                        Strings.append(S);
+                    }
+                    Value = static_cast<souffle::RamDomain>(It->second);
+                }
+                append(Tuples, static_cast<int64_t>(Value));
+            }
+        }
+
+        std::string Header;
+        append(Header, BinaryFactsMagic);
+        append(Header, static_cast<uint32_t>(Symbols.size()));
+        for(size_t I = 0; I < Symbols.size(); I++)
+        {
+            Header += Relation.getAttrType(I)[0];
+        }
+        append(Header, static_cast<uint64_t>(Indices.size()));
+        append(Strings, static_cast<uint64_t>(Relation.size()));
+
+        std::ofstream File(Path, std::ios::out | std::ios::binary);
+        File.write(Header.data(), Header.size());
+        File.write(Strings.data(), Strings.size());
+        File.write(Tuples.data(), Tuples.size());
+    }
+
+    // Read a tab-separated facts file into a relation.
+    bool readRelation(souffle::Relation &Relation, std::ifstream &File)
+    {
+        std::vector<bool> Symbols = symbolAttributes(Relation);
+        std::string Line;
+        while(std::getline(File, Line))
+        {
+            souffle::tuple Row(&Relation);
+            size_t Begin = 0;
+            for(size_t I = 0; I < Symbols.size(); I++)
+            {
+                size_t End = I + 1 < Symbols.size() ? Line.find('\t', Begin) : Line.size();
+                if(End == std::string::npos)
+                {
+                    return false;
+                }
+                if(Symbols[I])
+                {
+                    Row << Line.substr(Begin, End - Begin);
+                }
+                else
+                {
+                    int64_t Value;
+                    auto [Ptr, Error] =
+                        std::from_chars(Line.data() + Begin, Line.data() + End, Value);
+                    if(Error != std::errc() || Ptr != Line.data() + End)
+                    {
+                        return false;
+                    }
+                    Row << static_cast<souffle::RamDomain>(Value);
+                }
+                Begin = End + 1;
+            }
+            Relation.insert(Row);
+        }
+        return true;
+    }
+
+    // Reader of the binary facts encoding written by `writeBinaryRelation'.
+    class BinaryFacts
+    {
+    public:
+        explicit BinaryFacts(std::ifstream &File)
+            : Buffer{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()}
+        {
+            uint32_t Magic = 0, Arity = 0;
+            if(!read(Magic) || Magic != BinaryFactsMagic || !read(Arity)
+               || Buffer.size() - Position < Arity)
+            {
+                Good = false;
+                return;
+            }
+            Types = Buffer.substr(Position, Arity);
+            Position += Arity;
+
+            uint64_t Count = 0;
+            Good = read(Count);
+            for(uint64_t I = 0; Good && I < Count; I++)
+            {
+                uint32_t Length = 0;
+                Good = read(Length) && Buffer.size() - Position >= Length;
+                if(Good)
+                {
+                    Strings.push_back(Buffer.substr(Position, Length));
+                    Position += Length;
                 }
-                if(Relation->getAttrType(I)[0] == 's')
+            }
+            Good = Good && read(Tuples);
+        }
+
+        bool good() const
+        {
+            return Good;
+        }
+
+        // Attribute type characters of the relation.
+        const std::string &types() const
+        {
+            return Types;
+        }
+
+        uint64_t tuples() const
+        {
+            return Tuples;
+        }
+
+        // Read the next value, resolving it to a string if it is a symbol.
+        bool value(int64_t &Value)
+        {
+            return Good = Good && read(Value);
+        }
+
+        bool symbol(std::string &Symbol)
+        {
+            int64_t Index = 0;
+            if(!value(Index) || Index < 0 || static_cast<uint64_t>(Index) >= Strings.size())
+            {
+                return Good = false;
+            }
+            Symbol = Strings[Index];
+            return true;
+        }
+
+    private:
+        template <typename T>
+        bool read(T &Value)
+        {
+            if(Buffer.size() - Position < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&Value, Buffer.data() + Position, sizeof(T));
+            Position += sizeof(T);
+            return true;
+        }
+
+        std::string Buffer;
+        size_t Position = 0;
+        bool Good = true;
+        std::string Types;
+        std::vector<std::string> Strings;
+        uint64_t Tuples = 0;
+    };
+
+    // Read a binary facts file into a relation.
+    bool readBinaryRelation(souffle::Relation &Relation, std::ifstream &File)
+    {
+        BinaryFacts Facts(File);
+        std::vector<bool> Symbols = symbolAttributes(Relation);
+        if(!Facts.good() || Facts.types().size() != Symbols.size())
+        {
+            return false;
+        }
+        for(size_t I = 0; I < Symbols.size(); I++)
+        {
+            if(Facts.types()[I] != Relation.getAttrType(I)[0])
+            {
+                return false;
+            }
+        }
+
+        for(uint64_t T = 0; T < Facts.tuples(); T++)
+        {
+            souffle::tuple Row(&Relation);
+            for(size_t I = 0; I < Symbols.size(); I++)
+            {
+                if(Symbols[I])
                 {
-                    File << SymbolTable.resolve(Tuple[I]);
+                    std::string Symbol;
+                    if(!Facts.symbol(Symbol))
+                    {
+                        return false;
+                    }
+                    Row << Symbol;
                 }
                 else
                 {
-                    File << Tuple[I];
+                    int64_t Value;
+                    if(!Facts.value(Value))
+                    {
+                        return false;
+                    }
+                    Row << static_cast<souffle::RamDomain>(Value);
                 }
             }
-            File << std::endl;
+            Relation.insert(Row);
+        }
+        return true;
+    }
+
+    // Read the first symbol of a facts file of either format.
+    std::optional<std::string> readSymbol(const std::string &Directory, const std::string &Name)
+    {
+        if(std::ifstream File{Directory + Name + ".facts.bin", std::ios::binary})
+        {
+            BinaryFacts Facts(File);
+            std::string Symbol;
+            if(Facts.good() && Facts.tuples() > 0 && !Facts.types().empty()
+               && Facts.types()[0] == 's' && Facts.symbol(Symbol))
+            {
+                return Symbol;
+            }
+        }
+        else if(std::ifstream File{Directory + Name + ".facts"})
+        {
+            std::string Line;
+            if(std::getline(File, Line))
+            {
+                return Line.substr(0, Line.find('\t'));
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Apply a function to each relation, spreading the relations over the
+    // given number of threads.
+    template <typename F>
+    void forEachRelation(std::vector<souffle::Relation *> Relations, unsigned int NThreads, F Fn)
+    {
+        // Start with the largest relations to balance the threads.
+        std::sort(Relations.begin(), Relations.end(),
+                  [](const souffle::Relation *A, const souffle::Relation *B) {
+                      return A->size() > B->size();
+                  });
+        parallelFor(Relations.size(), NThreads, [&](size_t I) { Fn(*Relations[I]); });
+    }
+} // namespace
+
+std::optional<DatalogProgram> DatalogProgram::read(const std::string &Directory,
+                                                   unsigned int NThreads, bool Lean)
+{
+    // Select the program of the target recorded in the facts.
+    std::optional<std::string> Isa = readSymbol(Directory, "binary_isa");
+    std::optional<std::string> Format = readSymbol(Directory, "binary_format");
+    if(!Isa || !Format)
+    {
+        return std::nullopt;
+    }
+    for(auto &[Target, Factory] : loaders())
+    {
+        auto [FileFormat, ISA] = Target;
+        if(*Isa == binaryISA(ISA) && *Format == binaryFormat(FileFormat))
+        {
+            std::optional<DatalogProgram> Program = Factory().program(NThreads, Lean);
+            if(Program && Program->readFacts(Directory))
+            {
+                return Program;
+            }
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+bool DatalogProgram::readFacts(const std::string &Directory)
+{
+    std::atomic<bool> Good{true};
+    forEachRelation(Program->getInputRelations(), threads(), [&](souffle::Relation &Relation) {
+        std::string Path = Directory + Relation.getName() + ".facts";
+        if(std::ifstream File{Path + ".bin", std::ios::binary})
+        {
+            Good = readBinaryRelation(Relation, File) && Good;
+        }
+        else if(std::ifstream File{Path})
+        {
+            Good = readRelation(Relation, File) && Good;
+        }
+    });
+    return Good;
+}
+
+void DatalogProgram::writeFacts(const std::string &Directory, bool Binary)
+{
+    forEachRelation(Program->getInputRelations(), threads(), [&](souffle::Relation &Relation) {
+        std::string Path = Directory + Relation.getName() + ".facts";
+        if(Binary)
+        {
+            writeBinaryRelation(Relation, Path + ".bin");
+        }
+        else
+        {
+            writeRelation(Relation, Path);
+        }
+    });
+}
+
+void DatalogProgram::writeRelations(const std::string &Directory)
+{
+    forEachRelation(Program->getOutputRelations(), threads(), [&](souffle::Relation &Relation) {
+        writeRelation(Relation, Directory + Relation.getName() + ".csv");
+    });
+}
+
+void DatalogProgram::retain(const std::set<std::string> &Relations)
+{
+    for(souffle::Relation *Relation : Program->getAllRelations())
+    {
+        if(Relations.count(Relation->getName()) == 0)
+        {
+            Relation->purge();
         }
-        File.close();
     }
 }
@@ -25,13 +25,20 @@
 
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <souffle/CompiledSouffle.h>
 #include <souffle/SouffleInterface.h>
 #include <gtirb/gtirb.hpp>
 
+#include "Relations.h"
+
 class CompositeLoader;
 
 class DatalogProgram
@@ -40,34 +47,123 @@ public:
     explicit DatalogProgram(std::shared_ptr<souffle::SouffleProgram> P) : Program{P} {};
     ~DatalogProgram() = default;
 
-    static std::optional<DatalogProgram> load(const gtirb::Module& Module);
+    // Build the program of the module's target and load its facts. A `Lean`
+    // program only outputs the relations used to build GTIRB; the complete
+    // program is used if the target has no lean variant.
+    static std::optional<DatalogProgram> load(
+        const gtirb::Module& Module, unsigned int NThreads = 1,
+        const std::optional<std::string>& DecodeCache = std::nullopt, bool Lean = false);
 
     template <typename T>
     void insert(const std::string& Name, const T& Data)
     {
         if(auto* Relation = Program->getRelation(Name))
         {
-            for(const auto Element : Data)
+            insert(Relation, Data);
+        }
+    }
+
+    // Insert records in bulk: records are encoded with `operator<<' into one
+    // block of rows, which is inserted in sorted order (see insertRows).
+    template <typename T>
+    static void insert(souffle::Relation* Relation, const T& Data)
+    {
+        size_t Arity = Relation->getArity();
+        souffle::tuple Row(Relation);
+        if(Arity == 0)
+        {
+            if(std::begin(Data) != std::end(Data))
             {
-                souffle::tuple Row(Relation);
-                Row << Element;
                 Relation->insert(Row);
             }
+            return;
+        }
+        std::vector<souffle::RamDomain> Rows;
+        for(const auto& Element : Data)
+        {
+            Row.rewind();
+            Row << Element;
+            for(size_t I = 0; I < Arity; I++)
+            {
+                Rows.push_back(Row[I]);
+            }
         }
+        insertRows(Relation, Rows);
     }
 
-    void writeFacts(const std::string& Directory);
+    // Insert records with interned names (e.g. instructions and register
+    // operands) in bulk. Names are resolved and interned in the symbol table
+    // once for the whole block instead of once per tuple. RelationSink flushes
+    // batches of such records through this path.
+    template <typename T>
+    void insertNamed(const std::string& Name, const std::vector<T>& Data)
+    {
+        if(auto* Relation = Program->getRelation(Name))
+        {
+            insertNamed(Relation, Data);
+        }
+    }
 
-    void writeRelations(const std::string& Directory)
+    template <typename T>
+    static void insertNamed(souffle::Relation* Relation, const std::vector<T>& Data)
     {
-        Program->printAll(Directory);
+        std::vector<souffle::RamDomain> Rows;
+        for(const T& Element : Data)
+        {
+            relations::append(Rows, Element);
+        }
+        insertRows(Relation, Rows, true);
     }
 
+    // Insert a block of rows of `getArity()' values. Rows are inserted in
+    // sorted order, so consecutive inserts land in neighbouring nodes of the
+    // relation's B-trees. If `Interned', values of symbol attributes are
+    // identifiers of interned names (see relations::intern), and each name
+    // used by the rows is looked up once.
+    static void insertRows(souffle::Relation* Relation, std::vector<souffle::RamDomain>& Rows,
+                           bool Interned = false);
+
+    // Build the program of the target recorded in a facts directory and load
+    // its input relations from the directory.
+    static std::optional<DatalogProgram> read(const std::string& Directory,
+                                              unsigned int NThreads = 1, bool Lean = false);
+
+    // Load input relations from `<name>.facts.bin' or `<name>.facts' files.
+    // Relations without a file are left empty.
+    bool readFacts(const std::string& Directory);
+
+    // Write input relations to `<name>.facts' files (or to `<name>.facts.bin'
+    // files in binary form) and output relations to `<name>.csv' files, using
+    // the configured number of threads.
+    void writeFacts(const std::string& Directory, bool Binary = false);
+    void writeRelations(const std::string& Directory);
+
+    // Release the tuples of all relations except `Relations', e.g. the output
+    // relations that are not read after the program has run. This does not
+    // lower the peak memory of the run itself.
+    void retain(const std::set<std::string>& Relations);
+
     void threads(uint8_t N)
     {
         Program->setNumThreads(N);
     }
 
+    unsigned int threads() const
+    {
+        return static_cast<unsigned int>(Program->getNumThreads());
+    }
+
+    // Directory of the decode cache used by instruction loaders, if any.
+    void decodeCache(const std::optional<std::string>& Directory)
+    {
+        DecodeCache = Directory;
+    }
+
+    const std::optional<std::string>& decodeCache() const
+    {
+        return DecodeCache;
+    }
+
     void run()
     {
         Program->run();
@@ -91,6 +187,82 @@ private:
     static std::map<Target, Factory>& loaders();
 
     std::shared_ptr<souffle::SouffleProgram> Program;
+    std::optional<std::string> DecodeCache;
+};
+
+// Whether records of type T hold interned names that can be inserted in bulk
+// with DatalogProgram::insertNamed (see relations::append).
+template <typename T, typename = void>
+struct HasInternedNames : std::false_type
+{
+};
+
+template <typename T>
+struct HasInternedNames<T, std::void_t<decltype(relations::append(
+                               std::declval<std::vector<souffle::RamDomain>&>(),
+                               std::declval<const T&>()))>> : std::true_type
+{
+};
+
+// Buffer of facts that are inserted into a relation in bounded batches, so that
+// loaders can hand facts to the program as they produce them instead of first
+// collecting complete relations.
+template <typename T>
+class RelationSink
+{
+public:
+    RelationSink(DatalogProgram& Program, const std::string& Name, size_t N = 4096)
+        : Relation{Program.get()->getRelation(Name)}, BatchSize{N}
+    {
+        if(Relation)
+        {
+            Batch.reserve(BatchSize);
+        }
+    }
+
+    RelationSink(RelationSink&& Sink) = default;
+    RelationSink(const RelationSink&) = delete;
+    RelationSink& operator=(const RelationSink&) = delete;
+
+    ~RelationSink()
+    {
+        flush();
+    }
+
+    void push(const T& Fact)
+    {
+        // Facts of relations not in the program are dropped.
+        if(!Relation)
+        {
+            return;
+        }
+        Batch.push_back(Fact);
+        if(Batch.size() >= BatchSize)
+        {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        if(!Batch.empty())
+        {
+            if constexpr(HasInternedNames<T>::value)
+            {
+                DatalogProgram::insertNamed(Relation, Batch);
+            }
+            else
+            {
+                DatalogProgram::insert(Relation, Batch);
+            }
+            Batch.clear();
+        }
+    }
+
+private:
+    souffle::Relation* Relation;
+    size_t BatchSize;
+    std::vector<T> Batch;
 };
 
 #endif // SRC_GTIRB_DECODER_DATALOGPROGRAM_H_
@@ -0,0 +1,57 @@
+//===- Parallel.h -----------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_GTIRB_DECODER_PARALLEL_H_
+#define SRC_GTIRB_DECODER_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+// Run `Fn(I)' for every `I' in [0, N), distributing the indices over up to
+// `NThreads' threads, one of which is the calling thread. Indices are taken
+// in increasing order, and exceptions thrown by `Fn' are rethrown here.
+template <typename F>
+void parallelFor(size_t N, unsigned int NThreads, F Fn)
+{
+    std::atomic<size_t> Next{0};
+    auto Work = [&]() {
+        for(size_t I = Next++; I < N; I = Next++)
+        {
+            Fn(I);
+        }
+    };
+    std::vector<std::future<void>> Tasks;
+    for(size_t T = 1; T < std::min<size_t>(NThreads, N); T++)
+    {
+        Tasks.push_back(std::async(std::launch::async, Work));
+    }
+    Work();
+    for(std::future<void>& Task : Tasks)
+    {
+        Task.get();
+    }
+}
+
+#endif // SRC_GTIRB_DECODER_PARALLEL_H_
@@ -22,6 +22,102 @@
 //===----------------------------------------------------------------------===//
 #include "Relations.h"
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace relations
+{
+    namespace
+    {
+        struct NameTable
+        {
+            // The empty string is always interned with the default identifier.
+            NameTable() : Names(1)
+            {
+                Ids.emplace(Names.front(), 0);
+            }
+
+            std::mutex Mutex;
+            std::deque<std::string> Names;
+            std::unordered_map<std::string_view, uint32_t> Ids;
+        };
+
+        NameTable& names()
+        {
+            static NameTable Table;
+            return Table;
+        }
+    } // namespace
+
+    NameId intern(std::string_view Name)
+    {
+        NameTable& Table = names();
+        std::lock_guard<std::mutex> Lock(Table.Mutex);
+        if(auto It = Table.Ids.find(Name); It != Table.Ids.end())
+        {
+            return NameId{It->second};
+        }
+        // Deque elements are never moved, so the views used as keys stay valid.
+        uint32_t Id = static_cast<uint32_t>(Table.Names.size());
+        const std::string& S = Table.Names.emplace_back(Name);
+        Table.Ids.emplace(S, Id);
+        return NameId{Id};
+    }
+
+    const std::string& resolve(NameId Name)
+    {
+        NameTable& Table = names();
+        std::lock_guard<std::mutex> Lock(Table.Mutex);
+        return Table.Names.at(Name.Id);
+    }
+
+    std::vector<std::string_view> resolve(const std::vector<NameId>& Names)
+    {
+        NameTable& Table = names();
+        std::lock_guard<std::mutex> Lock(Table.Mutex);
+        std::vector<std::string_view> Strings;
+        Strings.reserve(Names.size());
+        for(NameId Name : Names)
+        {
+            Strings.push_back(Table.Names.at(Name.Id));
+        }
+        return Strings;
+    }
+
+    void append(std::vector<souffle::RamDomain>& Rows, const Instruction& I)
+    {
+        Rows.push_back(static_cast<souffle::RamDomain>(static_cast<uint64_t>(I.Addr)));
+        Rows.push_back(static_cast<souffle::RamDomain>(I.Size));
+        Rows.push_back(I.Prefix.Id);
+        Rows.push_back(I.Name.Id);
+        for(size_t i = 0; i < 4; ++i)
+        {
+            Rows.push_back(i < I.OpCodes.size() ? static_cast<souffle::RamDomain>(I.OpCodes[i])
+                                                : 0);
+        }
+        Rows.push_back(I.ImmediateOffset);
+        Rows.push_back(I.DisplacementOffset);
+    }
+
+    void append(std::vector<souffle::RamDomain>& Rows, const std::pair<RegOp, uint64_t>& Op)
+    {
+        Rows.push_back(static_cast<souffle::RamDomain>(Op.second));
+        Rows.push_back(Op.first.Id);
+    }
+
+    void append(std::vector<souffle::RamDomain>& Rows, const std::pair<IndirectOp, uint64_t>& Op)
+    {
+        Rows.push_back(static_cast<souffle::RamDomain>(Op.second));
+        Rows.push_back(Op.first.Reg1.Id);
+        Rows.push_back(Op.first.Reg2.Id);
+        Rows.push_back(Op.first.Reg3.Id);
+        Rows.push_back(Op.first.Mult);
+        Rows.push_back(Op.first.Disp);
+        Rows.push_back(Op.first.Size);
+    }
+} // namespace relations
+
 namespace souffle
 {
     souffle::tuple& operator<<(souffle::tuple& T, const gtirb::Addr& A)
@@ -30,6 +126,12 @@ namespace souffle
         return T;
     }
 
+    souffle::tuple& operator<<(souffle::tuple& T, const relations::NameId& N)
+    {
+        T << relations::resolve(N);
+        return T;
+    }
+
     souffle::tuple& operator<<(souffle::tuple& T, const relations::Symbol& Symbol)
     {
         T << Symbol.Addr << Symbol.Size << Symbol.Type << Symbol.Binding << Symbol.SectionIndex
@@ -67,6 +169,12 @@ namespace souffle
         return T;
     }
 
+    souffle::tuple& operator<<(souffle::tuple& T, const relations::DataFill& Fill)
+    {
+        T << Fill.Begin << Fill.End << Fill.Value;
+        return T;
+    }
+
     souffle::tuple& operator<<(souffle::tuple& T, const relations::Padding& Block)
     {
         T << Block.Addr << Block.Size;
@@ -25,10 +25,12 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include <boost/container_hash/hash.hpp>
 #include <souffle/CompiledSouffle.h>
 #include <souffle/SouffleInterface.h>
 #include <gtirb/gtirb.hpp>
@@ -42,24 +44,64 @@ namespace relations
         T Item;
     };
 
+    // Range of data bytes that all hold the same value.
+    struct DataFill
+    {
+        gtirb::Addr Begin;
+        gtirb::Addr End;
+        uint8_t Value;
+    };
+
+    // Identifier of a name (register, mnemonic, prefix) interned in a
+    // process-wide table. Names are only resolved to strings when they are
+    // inserted into a relation.
+    struct NameId
+    {
+        uint32_t Id = 0;
+
+        constexpr bool operator==(const NameId& N) const noexcept
+        {
+            return Id == N.Id;
+        }
+
+        constexpr bool operator!=(const NameId& N) const noexcept
+        {
+            return Id != N.Id;
+        }
+
+        constexpr bool operator<(const NameId& N) const noexcept
+        {
+            return Id < N.Id;
+        }
+    };
+
+    // Intern a name, returning the same identifier for equal strings.
+    NameId intern(std::string_view Name);
+
+    // Get the string of an interned name.
+    const std::string& resolve(NameId Name);
+
+    // Get the strings of several interned names at once.
+    std::vector<std::string_view> resolve(const std::vector<NameId>& Names);
+
     struct Instruction
     {
         gtirb::Addr Addr;
         uint64_t Size;
-        std::string Prefix;
-        std::string Name;
+        NameId Prefix;
+        NameId Name;
         std::vector<uint64_t> OpCodes;
         uint8_t ImmediateOffset;
         uint8_t DisplacementOffset;
     };
 
     using ImmOp = int64_t;
-    using RegOp = std::string;
+    using RegOp = NameId;
     struct IndirectOp
     {
-        std::string Reg1;
-        std::string Reg2;
-        std::string Reg3;
+        NameId Reg1;
+        NameId Reg2;
+        NameId Reg3;
         int64_t Mult;
         int64_t Disp;
         int Size;
@@ -69,6 +111,12 @@ namespace relations
             return std::tie(Reg1, Reg2, Reg3, Mult, Disp, Size)
                    < std::tie(Op.Reg1, Op.Reg2, Op.Reg3, Op.Mult, Op.Disp, Op.Size);
         };
+
+        constexpr bool operator==(const IndirectOp& Op) const noexcept
+        {
+            return std::tie(Reg1, Reg2, Reg3, Mult, Disp, Size)
+                   == std::tie(Op.Reg1, Op.Reg2, Op.Reg3, Op.Mult, Op.Disp, Op.Size);
+        };
     };
 
     using Operand = std::variant<ImmOp, RegOp, IndirectOp>;
@@ -159,12 +207,50 @@ namespace relations
         int64_t Offset;
     };
 
+    // Append the tuple of a record with interned names to a block of rows
+    // (see DatalogProgram::insertRows). Names are stored as their identifier.
+    void append(std::vector<souffle::RamDomain>& Rows, const Instruction& I);
+
+    void append(std::vector<souffle::RamDomain>& Rows, const std::pair<RegOp, uint64_t>& Op);
+
+    void append(std::vector<souffle::RamDomain>& Rows, const std::pair<IndirectOp, uint64_t>& Op);
+
 } // namespace relations
 
+namespace std
+{
+    template <>
+    struct hash<relations::NameId>
+    {
+        size_t operator()(const relations::NameId& N) const noexcept
+        {
+            return hash<uint32_t>{}(N.Id);
+        }
+    };
+
+    template <>
+    struct hash<relations::IndirectOp>
+    {
+        size_t operator()(const relations::IndirectOp& Op) const noexcept
+        {
+            size_t Seed = 0;
+            boost::hash_combine(Seed, Op.Reg1.Id);
+            boost::hash_combine(Seed, Op.Reg2.Id);
+            boost::hash_combine(Seed, Op.Reg3.Id);
+            boost::hash_combine(Seed, Op.Mult);
+            boost::hash_combine(Seed, Op.Disp);
+            boost::hash_combine(Seed, Op.Size);
+            return Seed;
+        }
+    };
+} // namespace std
+
 namespace souffle
 {
     souffle::tuple& operator<<(souffle::tuple& T, const gtirb::Addr& A);
 
+    souffle::tuple& operator<<(souffle::tuple& T, const relations::NameId& N);
+
     souffle::tuple& operator<<(souffle::tuple& T, const relations::Symbol& S);
 
     souffle::tuple& operator<<(souffle::tuple& T, const relations::Section& S);
@@ -188,6 +274,8 @@ namespace souffle
         return T;
     }
 
+    souffle::tuple& operator<<(souffle::tuple& T, const relations::DataFill& Fill);
+
     souffle::tuple& operator<<(souffle::tuple& T, const relations::Padding& Block);
 
     souffle::tuple& operator<<(souffle::tuple& T, const std::pair<gtirb::Addr, gtirb::Addr>& Pair);
@@ -0,0 +1,241 @@
+//===- Stats.cpp ------------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include "Stats.h"
+
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::string quote(const std::string& S)
+    {
+        std::ostringstream Stream;
+        Stream << '"';
+        for(char C : S)
+        {
+            switch(C)
+            {
+                case '"':
+                    Stream << "\\\"";
+                    break;
+                case '\\':
+                    Stream << "\\\\";
+                    break;
+                case '\n':
+                    Stream << "\\n";
+                    break;
+                case '\t':
+                    Stream << "\\t";
+                    break;
+                default:
+                    if(static_cast<unsigned char>(C) < 0x20)
+                    {
+                        Stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                               << static_cast<int>(C);
+                    }
+                    else
+                    {
+                        Stream << C;
+                    }
+            }
+        }
+        Stream << '"';
+        return Stream.str();
+    }
+} // namespace
+
+Stats::Phase::Phase(Stats& S, std::string N, bool MeasureCpu)
+    : Report{S}, Active{S.enabled()}, Name{std::move(N)}
+{
+    if(Active)
+    {
+        Start = std::chrono::steady_clock::now();
+        if(MeasureCpu)
+        {
+            Cpu = cpuTime();
+        }
+    }
+}
+
+Stats::Phase::~Phase()
+{
+    stop();
+}
+
+void Stats::Phase::stop()
+{
+    if(Active)
+    {
+        std::chrono::duration<double> Wall = std::chrono::steady_clock::now() - Start;
+        std::optional<double> CpuTime;
+        if(Cpu)
+        {
+            CpuTime = cpuTime() - *Cpu;
+        }
+        Report.record(Name, {Wall.count(), CpuTime, peakRss()});
+        Active = false;
+    }
+}
+
+Stats& Stats::instance()
+{
+    static Stats Report;
+    return Report;
+}
+
+void Stats::value(const std::string& Key, uint64_t Value)
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Values.emplace_back(Key, std::to_string(Value));
+}
+
+void Stats::value(const std::string& Key, const std::string& Value)
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Values.emplace_back(Key, quote(Value));
+}
+
+void Stats::relations(souffle::SouffleProgram* Program, const std::string& Prefix)
+{
+    if(!Enabled)
+    {
+        return;
+    }
+    // Relations can be both input and output relations.
+    std::vector<souffle::Relation*> Inputs = Program->getInputRelations();
+    std::vector<souffle::Relation*> Outputs = Program->getOutputRelations();
+    std::lock_guard<std::mutex> Lock(Mutex);
+    std::set<souffle::Relation*> Seen;
+    for(auto* List : {&Inputs, &Outputs})
+    {
+        for(souffle::Relation* Relation : *List)
+        {
+            if(Seen.insert(Relation).second)
+            {
+                Relations.emplace_back(Prefix + Relation->getName(), Relation->size());
+            }
+        }
+    }
+}
+
+void Stats::record(const std::string& Name, const Usage& U)
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Phases.emplace_back(Name, U);
+}
+
+void Stats::write(std::ostream& Stream) const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Stream << "{\n";
+    for(const auto& [Key, Value] : Values)
+    {
+        Stream << "  " << quote(Key) << ": " << Value << ",\n";
+    }
+
+    Stream << "  \"phases\": [";
+    for(size_t I = 0; I < Phases.size(); I++)
+    {
+        const auto& [Name, U] = Phases[I];
+        Stream << (I > 0 ? ",\n" : "\n") << "    {\"name\": " << quote(Name) << std::fixed
+               << std::setprecision(6) << ", \"wall_seconds\": " << U.Wall
+               << ", \"cpu_seconds\": ";
+        if(U.Cpu)
+        {
+            Stream << *U.Cpu;
+        }
+        else
+        {
+            Stream << "null";
+        }
+        Stream << ", \"peak_rss_bytes\": " << U.PeakRss << "}";
+    }
+    Stream << "\n  ],\n";
+
+    Stream << "  \"relations\": {";
+    for(size_t I = 0; I < Relations.size(); I++)
+    {
+        const auto& [Name, Size] = Relations[I];
+        Stream << (I > 0 ? ",\n" : "\n") << "    " << quote(Name) << ": " << Size;
+    }
+    Stream << "\n  }\n}\n";
+}
+
+double Stats::cpuTime()
+{
+#if defined(_WIN32)
+    FILETIME Creation, Exit, Kernel, User;
+    if(!GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User))
+    {
+        return 0;
+    }
+    auto Seconds = [](const FILETIME& T) {
+        ULARGE_INTEGER I;
+        I.LowPart = T.dwLowDateTime;
+        I.HighPart = T.dwHighDateTime;
+        return static_cast<double>(I.QuadPart) / 1e7;
+    };
+    return Seconds(Kernel) + Seconds(User);
+#else
+    struct rusage Usage;
+    if(getrusage(RUSAGE_SELF, &Usage) != 0)
+    {
+        return 0;
+    }
+    auto Seconds = [](const struct timeval& T) { return T.tv_sec + T.tv_usec / 1e6; };
+    return Seconds(Usage.ru_utime) + Seconds(Usage.ru_stime);
+#endif
+}
+
+uint64_t Stats::peakRss()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS Counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)))
+    {
+        return 0;
+    }
+    return Counters.PeakWorkingSetSize;
+#else
+    struct rusage Usage;
+    if(getrusage(RUSAGE_SELF, &Usage) != 0)
+    {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(Usage.ru_maxrss);
+#else
+    // Linux reports kilobytes.
+    return static_cast<uint64_t>(Usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
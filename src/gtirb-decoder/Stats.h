@@ -0,0 +1,116 @@
+//===- Stats.h --------------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_GTIRB_DECODER_STATS_H_
+#define SRC_GTIRB_DECODER_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <souffle/SouffleInterface.h>
+
+// Resource usage of the phases of a run, written as JSON with --stats-json.
+// Recording is disabled unless the report has been enabled, in which case
+// phases cost a couple of system calls each.
+class Stats
+{
+public:
+    struct Usage
+    {
+        double Wall = 0;
+        // Process CPU time, if it is measured.
+        std::optional<double> Cpu;
+        uint64_t PeakRss = 0;
+    };
+
+    // Measure the phase that lasts for the lifetime of this object. CPU time
+    // is that of the whole process, so it is not measured (`MeasureCpu' is
+    // false) for phases that run concurrently with other phases.
+    class Phase
+    {
+    public:
+        Phase(Stats& S, std::string N, bool MeasureCpu = true);
+        Phase(Phase&&) = delete;
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+        ~Phase();
+
+        // End the phase before the end of the scope.
+        void stop();
+
+    private:
+        Stats& Report;
+        bool Active;
+        std::string Name;
+        std::chrono::steady_clock::time_point Start;
+        std::optional<double> Cpu;
+    };
+
+    static Stats& instance();
+
+    void enable()
+    {
+        Enabled = true;
+    }
+
+    bool enabled() const
+    {
+        return Enabled;
+    }
+
+    Phase phase(std::string Name, bool MeasureCpu = true)
+    {
+        return Phase(*this, std::move(Name), MeasureCpu);
+    }
+
+    // Record a named value of the run.
+    void value(const std::string& Key, uint64_t Value);
+    void value(const std::string& Key, const std::string& Value);
+
+    // Record the number of tuples of the input and output relations of a
+    // program, prefixing their names with `Prefix'.
+    void relations(souffle::SouffleProgram* Program, const std::string& Prefix = "");
+
+    void write(std::ostream& Stream) const;
+
+    // Process CPU time in seconds (all threads) and peak resident set size in
+    // bytes so far.
+    static double cpuTime();
+    static uint64_t peakRss();
+
+private:
+    void record(const std::string& Name, const Usage& U);
+
+    bool Enabled = false;
+    mutable std::mutex Mutex;
+    std::vector<std::pair<std::string, std::string>> Values;
+    std::vector<std::pair<std::string, Usage>> Phases;
+    std::vector<std::pair<std::string, uint64_t>> Relations;
+};
+
+#endif // SRC_GTIRB_DECODER_STATS_H_
@@ -29,24 +29,25 @@
 void Arm64Loader::insert(const Arm64Facts& Facts, DatalogProgram& Program)
 {
     auto& [Instructions, Operands] = Facts;
-    Program.insert("instruction_complete", Instructions.instructions());
+    Program.insertNamed("instruction_complete", Instructions.instructions());
     Program.insert("invalid_op_code", Instructions.invalid());
     Program.insert("op_immediate", Operands.imm());
-    Program.insert("op_regdirect", Operands.reg());
-    Program.insert("op_indirect", Operands.indirect());
+    Program.insertNamed("op_regdirect", Operands.reg());
+    Program.insertNamed("op_indirect", Operands.indirect());
     Program.insert("op_barrier", Operands.barrier());
     Program.insert("op_prefetch", Operands.prefetch());
 }
 
 void Arm64Loader::decode(Arm64Facts& Facts, const uint8_t* Bytes, uint64_t Size, uint64_t Addr)
 {
-    // Decode instruction with Capstone.
-    cs_insn* CsInsn;
-    size_t Count = cs_disasm(*CsHandle, Bytes, Size, Addr, 1, &CsInsn);
+    // Decode instruction with Capstone into the preallocated buffer.
+    size_t CodeSize = Size;
+    uint64_t Address = Addr;
+    bool Decoded = cs_disasm_iter(*CsHandle, &Bytes, &CodeSize, &Address, CsInsn.get());
 
     // Build datalog instruction facts from Capstone instruction.
     std::optional<relations::Instruction> Instruction;
-    if(Count > 0)
+    if(Decoded)
     {
         Instruction = build(Facts, *CsInsn);
     }
@@ -61,18 +62,16 @@ void Arm64Loader::decode(Arm64Facts& Facts, const uint8_t* Bytes, uint64_t Size,
         // Add address to list of invalid instruction locations.
         Facts.Instructions.invalid(gtirb::Addr(Addr));
     }
-
-    cs_free(CsInsn, Count);
 }
 
 std::optional<relations::Instruction> Arm64Loader::build(Arm64Facts& Facts,
                                                          const cs_insn& CsInstruction)
 {
     const cs_arm64& Details = CsInstruction.detail->arm64;
-    std::string Name = uppercase(CsInstruction.mnemonic);
+    auto [Prefix, Name] = Mnemonics.get(CsInstruction.id, CsInstruction.mnemonic);
     std::vector<uint64_t> OpCodes;
 
-    if(Name != "NOP")
+    if(Name != Nop)
     {
         int OpCount = Details.op_count;
         for(int i = 0; i < OpCount; i++)
@@ -100,7 +99,7 @@ std::optional<relations::Instruction> Arm64Loader::build(Arm64Facts& Facts,
 
     gtirb::Addr Addr(CsInstruction.address);
     uint64_t Size(CsInstruction.size);
-    return relations::Instruction{Addr, Size, "", Name, OpCodes, 0, 0};
+    return relations::Instruction{Addr, Size, Prefix, Name, OpCodes, 0, 0};
 }
 
 std::optional<relations::Arm64Operand> Arm64Loader::build(const cs_arm64_op& CsOp)
@@ -108,7 +107,7 @@ std::optional<relations::Arm64Operand> Arm64Loader::build(const cs_arm64_op& CsO
     using namespace relations;
 
     auto registerName = [this](uint64_t Reg) {
-        return (Reg == ARM_REG_INVALID) ? "NONE" : uppercase(cs_reg_name(*CsHandle, Reg));
+        return Reg < Registers.size() ? Registers[Reg] : Registers[ARM64_REG_INVALID];
     };
 
     switch(CsOp.type)
@@ -264,3 +263,23 @@ namespace souffle
         return T;
     }
 } // namespace souffle
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::BarrierOp& Op)
+{
+    return Out << Op.Value;
+}
+
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::BarrierOp& Op)
+{
+    return In >> Op.Value;
+}
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::PrefetchOp& Op)
+{
+    return Out << Op.Value;
+}
+
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::PrefetchOp& Op)
+{
+    return In >> Op.Value;
+}
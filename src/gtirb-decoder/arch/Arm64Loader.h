@@ -24,7 +24,9 @@
 #define SRC_GTIRB_DECODER_ARCH_ARM64DECODER_H_
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <capstone/capstone.h>
 
@@ -36,24 +38,51 @@ namespace relations
     struct BarrierOp
     {
         std::string Value;
-        bool operator<(const BarrierOp& Op) const noexcept
+        bool operator==(const BarrierOp& Op) const noexcept
         {
-            return Value < Op.Value;
+            return Value == Op.Value;
         }
     };
 
     struct PrefetchOp
     {
         std::string Value;
-        bool operator<(const PrefetchOp& Op) const noexcept
+        bool operator==(const PrefetchOp& Op) const noexcept
         {
-            return Value < Op.Value;
+            return Value == Op.Value;
         }
     };
 
     using Arm64Operand = std::variant<ImmOp, RegOp, IndirectOp, PrefetchOp, BarrierOp>;
 } // namespace relations
 
+namespace std
+{
+    template <>
+    struct hash<relations::BarrierOp>
+    {
+        size_t operator()(const relations::BarrierOp& Op) const noexcept
+        {
+            return hash<string>{}(Op.Value);
+        }
+    };
+
+    template <>
+    struct hash<relations::PrefetchOp>
+    {
+        size_t operator()(const relations::PrefetchOp& Op) const noexcept
+        {
+            return hash<string>{}(Op.Value);
+        }
+    };
+} // namespace std
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::BarrierOp& Op);
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::BarrierOp& Op);
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::PrefetchOp& Op);
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::PrefetchOp& Op);
+
 class Arm64OperandFacts : public OperandFacts
 {
 public:
@@ -76,19 +105,30 @@ public:
         return std::visit(*this, Op);
     }
 
-    const std::map<relations::BarrierOp, uint64_t>& barrier() const
+    const std::vector<std::pair<relations::BarrierOp, uint64_t>>& barrier() const
+    {
+        return Barrier.entries();
+    }
+
+    const std::vector<std::pair<relations::PrefetchOp, uint64_t>>& prefetch() const
     {
-        return Barrier;
+        return Prefetch.entries();
     }
 
-    const std::map<relations::PrefetchOp, uint64_t>& prefetch() const
+    std::vector<relations::Arm64Operand> operands() const
     {
-        return Prefetch;
+        std::vector<relations::Arm64Operand> Operands(size());
+        collect(imm(), Operands);
+        collect(reg(), Operands);
+        collect(indirect(), Operands);
+        collect(barrier(), Operands);
+        collect(prefetch(), Operands);
+        return Operands;
     }
 
 private:
-    std::map<relations::BarrierOp, uint64_t> Barrier;
-    std::map<relations::PrefetchOp, uint64_t> Prefetch;
+    OperandTable<relations::BarrierOp> Barrier;
+    OperandTable<relations::PrefetchOp> Prefetch;
 };
 
 struct Arm64Facts
@@ -112,17 +152,38 @@ public:
         [[maybe_unused]] cs_err Err = cs_open(CS_ARCH_ARM64, CS_MODE_ARM, CsHandle.get());
         assert(Err == CS_ERR_OK && "Failed to initialize ARM64 disassembler.");
         cs_option(*CsHandle, CS_OPT_DETAIL, CS_OPT_ON);
+
+        // Allocate a reusable instruction buffer for the handle.
+        CsInsn.reset(cs_malloc(*CsHandle), [](cs_insn* Insn) { cs_free(Insn, 1); });
+
+        // Intern uppercase register names indexed by Capstone register id.
+        Registers.push_back(relations::intern("NONE"));
+        for(unsigned int Reg = ARM64_REG_INVALID + 1; Reg < ARM64_REG_ENDING; Reg++)
+        {
+            const char* Name = cs_reg_name(*CsHandle, Reg);
+            Registers.push_back(relations::intern(Name ? uppercase(Name) : ""));
+        }
     }
 
 protected:
     void decode(Arm64Facts& Facts, const uint8_t* Bytes, uint64_t Size, uint64_t Addr) override;
     void insert(const Arm64Facts& Facts, DatalogProgram& Program) override;
 
+    std::unique_ptr<InstructionLoader> clone() const override
+    {
+        return std::make_unique<Arm64Loader>();
+    }
+
 private:
     std::optional<relations::Arm64Operand> build(const cs_arm64_op& CsOp);
     std::optional<relations::Instruction> build(Arm64Facts& Facts, const cs_insn& CsInstruction);
 
     std::shared_ptr<csh> CsHandle;
+    std::shared_ptr<cs_insn> CsInsn;
+
+    std::vector<relations::NameId> Registers;
+    MnemonicTable Mnemonics{false};
+    relations::NameId Nop = relations::intern("NOP");
 };
 
 std::optional<const char*> barrierValue(const arm64_barrier_op Op);
@@ -30,22 +30,23 @@
 void X64Loader::insert(const X64Facts& Facts, DatalogProgram& Program)
 {
     auto& [Instructions, Operands] = Facts;
-    Program.insert("instruction_complete", Instructions.instructions());
+    Program.insertNamed("instruction_complete", Instructions.instructions());
     Program.insert("invalid_op_code", Instructions.invalid());
     Program.insert("op_immediate", Operands.imm());
-    Program.insert("op_regdirect", Operands.reg());
-    Program.insert("op_indirect", Operands.indirect());
+    Program.insertNamed("op_regdirect", Operands.reg());
+    Program.insertNamed("op_indirect", Operands.indirect());
 }
 
 void X64Loader::decode(X64Facts& Facts, const uint8_t* Bytes, uint64_t Size, uint64_t Addr)
 {
-    // Decode instruction with Capstone.
-    cs_insn* CsInsn;
-    size_t Count = cs_disasm(*CsHandle, Bytes, Size, Addr, 1, &CsInsn);
+    // Decode instruction with Capstone into the preallocated buffer.
+    size_t CodeSize = Size;
+    uint64_t Address = Addr;
+    bool Decoded = cs_disasm_iter(*CsHandle, &Bytes, &CodeSize, &Address, CsInsn.get());
 
     // Build datalog instruction facts from Capstone instruction.
     std::optional<relations::Instruction> Instruction;
-    if(Count > 0)
+    if(Decoded)
     {
         Instruction = build(Facts, *CsInsn);
     }
@@ -60,18 +61,16 @@ void X64Loader::decode(X64Facts& Facts, const uint8_t* Bytes, uint64_t Size, uin
         // Add address to list of invalid instruction locations.
         Facts.Instructions.invalid(gtirb::Addr(Addr));
     }
-
-    cs_free(CsInsn, Count);
 }
 
 std::optional<relations::Instruction> X64Loader::build(X64Facts& Facts,
                                                        const cs_insn& CsInstruction)
 {
     cs_x86& Details = CsInstruction.detail->x86;
-    auto [Prefix, Name] = splitMnemonic(CsInstruction);
+    auto [Prefix, Name] = Mnemonics.get(CsInstruction.id, CsInstruction.mnemonic);
     std::vector<uint64_t> OpCodes;
 
-    if(Name != "NOP")
+    if(Name != Nop)
     {
         int OpCount = Details.op_count;
         for(int i = 0; i < OpCount; i++)
@@ -103,28 +102,10 @@ std::optional<relations::Instruction> X64Loader::build(X64Facts& Facts,
     return relations::Instruction{Addr, Size, Prefix, Name, OpCodes, Imm, Disp};
 }
 
-std::tuple<std::string, std::string> X64Loader::splitMnemonic(const cs_insn& CsInstruction)
-{
-    std::string PrefixName = uppercase(CsInstruction.mnemonic);
-    std::string Prefix, Name;
-    size_t Pos = PrefixName.find(' ');
-    if(Pos != std::string::npos)
-    {
-        Prefix = PrefixName.substr(0, Pos);
-        Name = PrefixName.substr(Pos + 1);
-    }
-    else
-    {
-        Prefix = "";
-        Name = PrefixName;
-    }
-    return {Prefix, Name};
-}
-
 std::optional<relations::Operand> X64Loader::build(const cs_x86_op& CsOp)
 {
     auto registerName = [this](uint64_t Reg) {
-        return (Reg == X86_REG_INVALID) ? "NONE" : uppercase(cs_reg_name(*CsHandle, Reg));
+        return Reg < Registers.size() ? Registers[Reg] : Registers[X86_REG_INVALID];
     };
 
     switch(CsOp.type)
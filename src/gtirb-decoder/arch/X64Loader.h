@@ -23,9 +23,11 @@
 #ifndef SRC_GTIRB_DECODER_ARCH_X64DECODER_H_
 #define SRC_GTIRB_DECODER_ARCH_X64DECODER_H_
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <capstone/capstone.h>
 
@@ -53,18 +55,38 @@ public:
         [[maybe_unused]] cs_err Err = cs_open(CS_ARCH_X86, CS_MODE_64, CsHandle.get());
         assert(Err == CS_ERR_OK && "Failed to initialize X64 disassembler.");
         cs_option(*CsHandle, CS_OPT_DETAIL, CS_OPT_ON);
+
+        // Allocate a reusable instruction buffer for the handle.
+        CsInsn.reset(cs_malloc(*CsHandle), [](cs_insn* Insn) { cs_free(Insn, 1); });
+
+        // Intern uppercase register names indexed by Capstone register id.
+        Registers.push_back(relations::intern("NONE"));
+        for(unsigned int Reg = X86_REG_INVALID + 1; Reg < X86_REG_ENDING; Reg++)
+        {
+            const char* Name = cs_reg_name(*CsHandle, Reg);
+            Registers.push_back(relations::intern(Name ? uppercase(Name) : ""));
+        }
     }
 
 protected:
     void decode(X64Facts& Facts, const uint8_t* Bytes, uint64_t Size, uint64_t Addr) override;
     void insert(const X64Facts& Facts, DatalogProgram& Program) override;
 
+    std::unique_ptr<InstructionLoader> clone() const override
+    {
+        return std::make_unique<X64Loader>();
+    }
+
 private:
     std::optional<relations::Operand> build(const cs_x86_op& CsOp);
     std::optional<relations::Instruction> build(X64Facts& Facts, const cs_insn& CsInstruction);
-    std::tuple<std::string, std::string> splitMnemonic(const cs_insn& CsInstruction);
 
     std::shared_ptr<csh> CsHandle;
+    std::shared_ptr<cs_insn> CsInsn;
+
+    std::vector<relations::NameId> Registers;
+    MnemonicTable Mnemonics{true};
+    relations::NameId Nop = relations::intern("NOP");
 };
 
 #endif // SRC_GTIRB_DECODER_ARCH_X64DECODER_H_
@@ -26,20 +26,25 @@
 
 void DataLoader::operator()(const gtirb::Module& Module, DatalogProgram& Program)
 {
-    DataFacts Facts;
+    DataFacts Facts(Program);
     load(Module, Facts);
-
-    Program.insert("data_byte", std::move(Facts.Bytes));
-    Program.insert("address_in_data", std::move(Facts.Addresses));
 }
 
 void DataLoader::load(const gtirb::Module& Module, DataFacts& Facts)
 {
-    assert(Module.getAddress() && "Module has non-addressable section data.");
-    Facts.Min = *Module.getAddress();
-
-    assert(Module.getSize() && "Module has non-calculable size.");
-    Facts.Max = *Module.getAddress() + *Module.getSize();
+    // Candidate pointers must refer to an address of a mapped section.
+    std::vector<PointerScanner::Range> Ranges;
+    for(const auto& Section : Module.sections())
+    {
+        std::optional<gtirb::Addr> Addr = Section.getAddress();
+        std::optional<uint64_t> Size = Section.getSize();
+        if(Addr && Size)
+        {
+            uint64_t Begin = static_cast<uint64_t>(*Addr);
+            Ranges.emplace_back(Begin, Begin + *Size);
+        }
+    }
+    Facts.Pointers = PointerScanner(static_cast<uint64_t>(PointerSize), std::move(Ranges));
 
     for(const auto& Section : Module.sections())
     {
@@ -64,35 +69,55 @@ void DataLoader::load(const gtirb::ByteInterval& ByteInterval, DataFacts& Facts)
     uint64_t Size = ByteInterval.getInitializedSize();
     auto Data = ByteInterval.rawBytes<const uint8_t>();
 
-    while(Size > 0)
+    // Bytes, with runs of a single value loaded as ranges.
+    for(uint64_t Offset = 0; Offset < Size;)
     {
-        // Single byte.
-        uint8_t Byte = *Data;
-        Facts.Bytes.push_back({Addr, Byte});
-
-        // Possible address.
-        if(Size >= static_cast<uint64_t>(PointerSize))
+        uint64_t End = Offset + 1;
+        while(End < Size && Data[End] == Data[Offset])
         {
-            gtirb::Addr Value;
+            End++;
+        }
+        fill(Addr + Offset, End - Offset, Data[Offset], Facts);
+        Offset = End;
+    }
 
-            switch(PointerSize)
-            {
-                case Pointer::DWORD:
-                    Value = gtirb::Addr(*((int32_t*)Data));
-                    break;
-                case Pointer::QWORD:
-                    Value = gtirb::Addr(*((int64_t*)Data));
-                    break;
-            }
+    // Possible addresses.
+    std::vector<uint64_t> Offsets;
+    Facts.Pointers.scan(Data, Size, Offsets);
+    for(uint64_t Offset : Offsets)
+    {
+        gtirb::Addr Value(Facts.Pointers.value(Data + Offset));
+        Facts.Addresses.push({Addr + Offset, Value});
+    }
+}
 
-            if((Value >= Facts.Min) && (Value <= Facts.Max))
-            {
-                Facts.Addresses.push_back({Addr, Value});
-            }
+void DataLoader::fill(gtirb::Addr Addr, uint64_t Size, uint8_t Value, DataFacts& Facts)
+{
+    uint64_t Begin = static_cast<uint64_t>(Addr);
+    uint64_t End = Begin + Size;
+
+    // Aligned interior of the run.
+    uint64_t FillBegin = End, FillEnd = End;
+    if(Size >= 2 * FillMargin + FillAlign)
+    {
+        FillBegin = (Begin + FillMargin + FillAlign - 1) / FillAlign * FillAlign;
+        FillEnd = (End - FillMargin) / FillAlign * FillAlign;
+        if(FillBegin >= FillEnd)
+        {
+            FillBegin = FillEnd = End;
         }
+    }
 
-        ++Addr;
-        ++Data;
-        --Size;
+    for(uint64_t A = Begin; A < FillBegin; A++)
+    {
+        Facts.Bytes.push({gtirb::Addr(A), Value});
+    }
+    if(FillBegin < FillEnd)
+    {
+        Facts.Fills.push({gtirb::Addr(FillBegin), gtirb::Addr(FillEnd), Value});
+    }
+    for(uint64_t A = FillEnd; A < End; A++)
+    {
+        Facts.Bytes.push({gtirb::Addr(A), Value});
     }
 }
@@ -29,12 +29,19 @@
 
 #include "../DatalogProgram.h"
 #include "../Relations.h"
+#include "PointerScanner.h"
 
 struct DataFacts
 {
-    gtirb::Addr Min, Max;
-    std::vector<relations::Data<uint8_t>> Bytes;
-    std::vector<relations::Data<gtirb::Addr>> Addresses;
+    explicit DataFacts(DatalogProgram& Program)
+        : Bytes{Program, "data_byte"},
+          Fills{Program, "data_fill_range"},
+          Addresses{Program, "address_in_data"} {};
+
+    PointerScanner Pointers;
+    RelationSink<relations::Data<uint8_t>> Bytes;
+    RelationSink<relations::DataFill> Fills;
+    RelationSink<relations::Data<gtirb::Addr>> Addresses;
 };
 
 // Load data sections.
@@ -56,6 +63,17 @@ protected:
     virtual void load(const gtirb::Module& Module, DataFacts& Facts);
     virtual void load(const gtirb::ByteInterval& Bytes, DataFacts& Facts);
 
+    // Load a run of identical bytes. Its interior is described by a single
+    // `data_fill_range' fact instead of a `data_byte' fact per byte.
+    void fill(gtirb::Addr Addr, uint64_t Size, uint8_t Value, DataFacts& Facts);
+
+    // Interiors of uniform runs start and end at multiples of `FillAlign' and
+    // keep at least `FillMargin' explicit bytes on both sides, so that rules
+    // reading a few bytes at the edge of a range see them as `data_byte'.
+    // Both values are assumed by the rules in data_fill.dl.
+    static constexpr uint64_t FillAlign = 64;
+    static constexpr uint64_t FillMargin = 16;
+
 private:
     Pointer PointerSize;
 };
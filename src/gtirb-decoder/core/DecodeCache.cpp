@@ -0,0 +1,194 @@
+//===- DecodeCache.cpp ------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include "DecodeCache.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/detail/sha1.hpp>
+
+#include "Version.h"
+
+namespace fs = boost::filesystem;
+
+// Identifies the layout of cache files; bump when the encoding changes.
+static const uint32_t CacheMagic = 0x44444331;
+
+std::string DecodeCacheWriter::str() const
+{
+    DecodeCacheWriter Table;
+    Table << static_cast<uint64_t>(Names.size());
+    for(relations::NameId N : Names)
+    {
+        Table << relations::resolve(N);
+    }
+    return Table.Body + Body;
+}
+
+DecodeCacheReader::DecodeCacheReader(std::string B) : Buffer{std::move(B)}
+{
+    uint64_t Count = 0;
+    *this >> Count;
+    for(uint64_t I = 0; Good && I < Count; I++)
+    {
+        std::string Name;
+        *this >> Name;
+        Names.push_back(relations::intern(Name));
+    }
+}
+
+DecodeCacheReader& DecodeCacheReader::operator>>(std::string& S)
+{
+    uint64_t Size = 0;
+    *this >> Size;
+    if(available(Size))
+    {
+        S.assign(Buffer, Position, Size);
+        Position += Size;
+    }
+    return *this;
+}
+
+DecodeCacheReader& DecodeCacheReader::operator>>(relations::NameId& N)
+{
+    uint32_t I = 0;
+    *this >> I;
+    Good = Good && I < Names.size();
+    if(Good)
+    {
+        N = Names[I];
+    }
+    return *this;
+}
+
+DecodeCacheReader& DecodeCacheReader::operator>>(gtirb::Addr& A)
+{
+    uint64_t Value = 0;
+    *this >> Value;
+    A = gtirb::Addr(Value);
+    return *this;
+}
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::Instruction& I)
+{
+    return Out << I.Addr << I.Size << I.Prefix << I.Name << I.OpCodes << I.ImmediateOffset
+               << I.DisplacementOffset;
+}
+
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::Instruction& I)
+{
+    return In >> I.Addr >> I.Size >> I.Prefix >> I.Name >> I.OpCodes >> I.ImmediateOffset
+           >> I.DisplacementOffset;
+}
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::IndirectOp& Op)
+{
+    return Out << Op.Reg1 << Op.Reg2 << Op.Reg3 << Op.Mult << Op.Disp << Op.Size;
+}
+
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::IndirectOp& Op)
+{
+    return In >> Op.Reg1 >> Op.Reg2 >> Op.Reg3 >> Op.Mult >> Op.Disp >> Op.Size;
+}
+
+std::string DecodeCache::key(const gtirb::ByteInterval& ByteInterval) const
+{
+    std::string Version = DDISASM_FULL_VERSION_STRING;
+    uint64_t ISA = static_cast<uint64_t>(ByteInterval.getSection()->getModule()->getISA());
+    uint64_t Addr = static_cast<uint64_t>(*ByteInterval.getAddress());
+    uint64_t Size = ByteInterval.getInitializedSize();
+
+    boost::uuids::detail::sha1 Hash;
+    Hash.process_bytes(Version.data(), Version.size() + 1);
+    Hash.process_bytes(&ISA, sizeof(ISA));
+    Hash.process_bytes(&Addr, sizeof(Addr));
+    Hash.process_bytes(&Size, sizeof(Size));
+    Hash.process_bytes(ByteInterval.rawBytes<const uint8_t>(), Size);
+
+    boost::uuids::detail::sha1::digest_type Digest;
+    Hash.get_digest(Digest);
+
+    std::ostringstream Key;
+    Key << std::hex << std::setfill('0');
+    for(auto Word : Digest)
+    {
+        Key << std::setw(2 * sizeof(Word)) << static_cast<uint64_t>(Word);
+    }
+    return Key.str();
+}
+
+std::string DecodeCache::path(const std::string& Key) const
+{
+    return (fs::path(Directory) / (Key + ".facts.bin")).string();
+}
+
+std::optional<std::string> DecodeCache::read(const std::string& Key) const
+{
+    std::ifstream File(path(Key), std::ios::in | std::ios::binary);
+    if(!File)
+    {
+        return std::nullopt;
+    }
+    std::string Buffer{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+
+    // Check the header before handing over the encoded facts.
+    std::string Header;
+    Header.append(reinterpret_cast<const char*>(&CacheMagic), sizeof(CacheMagic));
+    Header.append(Key);
+    if(Buffer.compare(0, Header.size(), Header) != 0)
+    {
+        return std::nullopt;
+    }
+    return Buffer.substr(Header.size());
+}
+
+void DecodeCache::write(const std::string& Key, const std::string& Buffer) const
+{
+    // Write to a temporary file and rename it, so that concurrent runs never
+    // read a partially written entry.
+    boost::system::error_code Error;
+    fs::path Tmp = fs::unique_path(path(Key) + ".%%%%-%%%%", Error);
+    if(Error)
+    {
+        return;
+    }
+    {
+        std::ofstream File(Tmp.string(), std::ios::out | std::ios::binary);
+        File.write(reinterpret_cast<const char*>(&CacheMagic), sizeof(CacheMagic));
+        File << Key << Buffer;
+        if(!File)
+        {
+            File.close();
+            fs::remove(Tmp, Error);
+            return;
+        }
+    }
+    fs::rename(Tmp, path(Key), Error);
+    if(Error)
+    {
+        fs::remove(Tmp, Error);
+    }
+}
@@ -0,0 +1,252 @@
+//===- DecodeCache.h --------------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_GTIRB_DECODER_CORE_DECODECACHE_H_
+#define SRC_GTIRB_DECODER_CORE_DECODECACHE_H_
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <gtirb/gtirb.hpp>
+
+#include "../Relations.h"
+
+// Binary encoding of decoded facts. Interned names are written once to a
+// string table at the head of the encoding and referenced by position.
+class DecodeCacheWriter
+{
+public:
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>, DecodeCacheWriter&> operator<<(T Value)
+    {
+        Body.append(reinterpret_cast<const char*>(&Value), sizeof(Value));
+        return *this;
+    }
+
+    DecodeCacheWriter& operator<<(const std::string& S)
+    {
+        *this << static_cast<uint64_t>(S.size());
+        Body.append(S);
+        return *this;
+    }
+
+    DecodeCacheWriter& operator<<(relations::NameId N)
+    {
+        auto [It, Inserted] = Positions.try_emplace(N, static_cast<uint32_t>(Names.size()));
+        if(Inserted)
+        {
+            Names.push_back(N);
+        }
+        return *this << It->second;
+    }
+
+    DecodeCacheWriter& operator<<(gtirb::Addr A)
+    {
+        return *this << static_cast<uint64_t>(A);
+    }
+
+    // Get the string table followed by the encoded facts.
+    std::string str() const;
+
+private:
+    std::string Body;
+    std::vector<relations::NameId> Names;
+    std::unordered_map<relations::NameId, uint32_t> Positions;
+};
+
+class DecodeCacheReader
+{
+public:
+    // Read the string table at the head of `Buffer`.
+    explicit DecodeCacheReader(std::string Buffer);
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>, DecodeCacheReader&> operator>>(T& Value)
+    {
+        if(available(sizeof(Value)))
+        {
+            std::memcpy(&Value, Buffer.data() + Position, sizeof(Value));
+            Position += sizeof(Value);
+        }
+        return *this;
+    }
+
+    DecodeCacheReader& operator>>(std::string& S);
+    DecodeCacheReader& operator>>(relations::NameId& N);
+    DecodeCacheReader& operator>>(gtirb::Addr& A);
+
+    // True if no read ran out of data or referenced an unknown name.
+    bool good() const
+    {
+        return Good;
+    }
+
+    void fail()
+    {
+        Good = false;
+    }
+
+private:
+    bool available(uint64_t N)
+    {
+        Good = Good && N <= Buffer.size() - Position;
+        return Good;
+    }
+
+    std::string Buffer;
+    size_t Position = 0;
+    bool Good = true;
+    std::vector<relations::NameId> Names;
+};
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::Instruction& I);
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::Instruction& I);
+
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const relations::IndirectOp& Op);
+DecodeCacheReader& operator>>(DecodeCacheReader& In, relations::IndirectOp& Op);
+
+template <typename... Ts>
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const std::variant<Ts...>& V)
+{
+    Out << static_cast<uint8_t>(V.index());
+    std::visit([&Out](const auto& Op) { Out << Op; }, V);
+    return Out;
+}
+
+template <typename... Ts>
+DecodeCacheReader& operator>>(DecodeCacheReader& In, std::variant<Ts...>& V)
+{
+    uint8_t Index = 0;
+    In >> Index;
+    if(Index >= sizeof...(Ts))
+    {
+        In.fail();
+        return In;
+    }
+    size_t I = 0;
+    auto Read = [&](auto Op) {
+        if(I++ == Index)
+        {
+            In >> Op;
+            V = std::move(Op);
+        }
+    };
+    (Read(Ts{}), ...);
+    return In;
+}
+
+template <typename T>
+DecodeCacheWriter& operator<<(DecodeCacheWriter& Out, const std::vector<T>& Items)
+{
+    Out << static_cast<uint64_t>(Items.size());
+    for(const T& Item : Items)
+    {
+        Out << Item;
+    }
+    return Out;
+}
+
+template <typename T>
+DecodeCacheReader& operator>>(DecodeCacheReader& In, std::vector<T>& Items)
+{
+    uint64_t Count = 0;
+    In >> Count;
+    for(uint64_t I = 0; In.good() && I < Count; I++)
+    {
+        T Item{};
+        In >> Item;
+        Items.push_back(std::move(Item));
+    }
+    return In;
+}
+
+// Content-addressed store of the facts decoded from byte intervals. Entries are
+// keyed by a hash of the interval's bytes and address, the ISA, and the ddisasm
+// version, so stale entries are never read.
+class DecodeCache
+{
+public:
+    explicit DecodeCache(std::string Dir) : Directory{std::move(Dir)} {};
+
+    std::string key(const gtirb::ByteInterval& ByteInterval) const;
+
+    template <typename T>
+    bool read(const std::string& Key, T& Facts) const
+    {
+        std::optional<std::string> Buffer = read(Key);
+        if(!Buffer)
+        {
+            return false;
+        }
+
+        DecodeCacheReader In(std::move(*Buffer));
+        decltype(Facts.Operands.operands()) Operands;
+        std::vector<relations::Instruction> Instructions;
+        std::vector<gtirb::Addr> Invalid;
+        In >> Operands >> Instructions >> Invalid;
+        if(!In.good())
+        {
+            return false;
+        }
+
+        // Operands are stored in index order, so adding them renumbers them
+        // as they were numbered when decoded.
+        for(const auto& Op : Operands)
+        {
+            Facts.Operands.add(Op);
+        }
+        for(const relations::Instruction& I : Instructions)
+        {
+            Facts.Instructions.add(I);
+        }
+        for(gtirb::Addr A : Invalid)
+        {
+            Facts.Instructions.invalid(A);
+        }
+        return true;
+    }
+
+    template <typename T>
+    void write(const std::string& Key, const T& Facts) const
+    {
+        DecodeCacheWriter Out;
+        Out << Facts.Operands.operands() << Facts.Instructions.instructions()
+            << Facts.Instructions.invalid();
+        write(Key, Out.str());
+    }
+
+private:
+    std::optional<std::string> read(const std::string& Key) const;
+    void write(const std::string& Key, const std::string& Buffer) const;
+
+    std::string path(const std::string& Key) const;
+
+    std::string Directory;
+};
+
+#endif // SRC_GTIRB_DECODER_CORE_DECODECACHE_H_
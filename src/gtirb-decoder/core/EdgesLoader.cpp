@@ -26,8 +26,8 @@
 
 void BlocksLoader(const gtirb::Module& Module, DatalogProgram& Program)
 {
-    std::vector<relations::Block> Blocks;
-    std::vector<relations::NextBlock> NextBlocks;
+    RelationSink<relations::Block> Blocks(Program, "block");
+    RelationSink<relations::NextBlock> NextBlocks(Program, "next_block");
 
     if(Module.code_blocks().empty())
     {
@@ -42,16 +42,13 @@ void BlocksLoader(const gtirb::Module& Module, DatalogProgram& Program)
         std::optional<gtirb::Addr> BlockAddr = Block.getAddress();
         assert(BlockAddr && PrevBlockAddr && "Found code block without address.");
 
-        Blocks.push_back({*BlockAddr, BlockSize});
+        Blocks.push({*BlockAddr, BlockSize});
         if(*PrevBlockAddr < *BlockAddr)
         {
-            NextBlocks.push_back({*PrevBlockAddr, *BlockAddr});
+            NextBlocks.push({*PrevBlockAddr, *BlockAddr});
         }
         PrevBlockAddr = BlockAddr;
     }
-
-    Program.insert("block", std::move(Blocks));
-    Program.insert("next_block", std::move(NextBlocks));
 }
 
 std::tuple<std::string, std::string, std::string> edgeProperties(const gtirb::EdgeLabel& Label)
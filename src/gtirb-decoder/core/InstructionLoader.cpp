@@ -22,9 +22,47 @@
 //===----------------------------------------------------------------------===//
 #include "InstructionLoader.h"
 
+#include <cstring>
+
 std::string uppercase(std::string S)
 {
     std::transform(S.begin(), S.end(), S.begin(),
                    [](unsigned char C) { return static_cast<unsigned char>(std::toupper(C)); });
     return S;
 };
+
+std::tuple<relations::NameId, relations::NameId> MnemonicTable::get(unsigned int Id,
+                                                                    const char* Mnemonic)
+{
+    if(Id >= Entries.size())
+    {
+        Entries.resize(Id + 1);
+    }
+
+    // The same instruction id is printed with only a few distinct mnemonics.
+    std::vector<Entry>& Candidates = Entries[Id];
+    for(const Entry& E : Candidates)
+    {
+        if(std::strcmp(E.Mnemonic.c_str(), Mnemonic) == 0)
+        {
+            return {E.Prefix, E.Name};
+        }
+    }
+
+    std::string PrefixName = uppercase(Mnemonic);
+    std::string Prefix, Name;
+    size_t Pos = Prefixed ? PrefixName.find(' ') : std::string::npos;
+    if(Pos != std::string::npos)
+    {
+        Prefix = PrefixName.substr(0, Pos);
+        Name = PrefixName.substr(Pos + 1);
+    }
+    else
+    {
+        Name = PrefixName;
+    }
+
+    Entry E{Mnemonic, relations::intern(Prefix), relations::intern(Name)};
+    Candidates.push_back(E);
+    return {E.Prefix, E.Name};
+}
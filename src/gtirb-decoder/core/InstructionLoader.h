@@ -23,12 +23,96 @@
 #ifndef SRC_GTIRB_DECODER_CORE_INSTRUCTIONLOADER_H_
 #define SRC_GTIRB_DECODER_CORE_INSTRUCTIONLOADER_H_
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <gtirb/gtirb.hpp>
 
 #include "../DatalogProgram.h"
+#include "../Parallel.h"
 #include "../Relations.h"
+#include "DecodeCache.h"
+
+// Open-addressing hash table assigning indices to distinct operands. Operands
+// are stored contiguously in the order they were added, i.e. sorted by index.
+template <typename T>
+class OperandTable
+{
+public:
+    using Entry = std::pair<T, uint64_t>;
+
+    // Find the index of an operand, adding it with index `Next` if not present.
+    std::pair<uint64_t, bool> try_emplace(const T& Op, uint64_t Next)
+    {
+        if(2 * (Entries.size() + 1) > Slots.size())
+        {
+            grow();
+        }
+
+        uint64_t Hash = hash(Op);
+        size_t Mask = Slots.size() - 1;
+        for(size_t Slot = Hash & Mask;; Slot = (Slot + 1) & Mask)
+        {
+            uint32_t E = Slots[Slot];
+            if(E == 0)
+            {
+                Slots[Slot] = static_cast<uint32_t>(Entries.size() + 1);
+                Hashes.push_back(Hash);
+                Entries.emplace_back(Op, Next);
+                return {Next, true};
+            }
+            if(Hashes[E - 1] == Hash && Entries[E - 1].first == Op)
+            {
+                return {Entries[E - 1].second, false};
+            }
+        }
+    }
+
+    const std::vector<Entry>& entries() const
+    {
+        return Entries;
+    }
+
+private:
+    static uint64_t hash(const T& Op)
+    {
+        // Finalize with a 64-bit mixer so that regular values (e.g. aligned
+        // addresses) spread over all slots.
+        uint64_t H = std::hash<T>{}(Op);
+        H ^= H >> 33;
+        H *= 0xff51afd7ed558ccdULL;
+        H ^= H >> 33;
+        H *= 0xc4ceb9fe1a85ec53ULL;
+        H ^= H >> 33;
+        return H;
+    }
+
+    void grow()
+    {
+        size_t Size = Slots.empty() ? 64 : Slots.size() * 2;
+        size_t Mask = Size - 1;
+        Slots.assign(Size, 0);
+        for(size_t I = 0; I < Entries.size(); I++)
+        {
+            size_t Slot = Hashes[I] & Mask;
+            while(Slots[Slot] != 0)
+            {
+                Slot = (Slot + 1) & Mask;
+            }
+            Slots[Slot] = static_cast<uint32_t>(I + 1);
+        }
+    }
+
+    // Slots hold one-based positions in `Entries`, with 0 marking empty slots.
+    std::vector<uint32_t> Slots;
+    std::vector<uint64_t> Hashes;
+    std::vector<Entry> Entries;
+};
 
 class OperandFacts
 {
@@ -53,52 +137,96 @@ public:
         return index(Indirect, Op);
     }
 
-    const std::map<relations::ImmOp, uint64_t>& imm() const
+    const std::vector<std::pair<relations::ImmOp, uint64_t>>& imm() const
     {
-        return Imm;
+        return Imm.entries();
     }
 
-    const std::map<relations::RegOp, uint64_t>& reg() const
+    const std::vector<std::pair<relations::RegOp, uint64_t>>& reg() const
     {
-        return Reg;
+        return Reg.entries();
     }
 
-    const std::map<relations::IndirectOp, uint64_t>& indirect() const
+    const std::vector<std::pair<relations::IndirectOp, uint64_t>>& indirect() const
     {
-        return Indirect;
+        return Indirect.entries();
+    }
+
+    // Number of distinct operands indexed so far.
+    uint64_t size() const
+    {
+        return Index - 1;
+    }
+
+    // Operands in the order they were first indexed, i.e. operand `I` is at
+    // position `I - 1`.
+    std::vector<relations::Operand> operands() const
+    {
+        std::vector<relations::Operand> Operands(size());
+        collect(imm(), Operands);
+        collect(reg(), Operands);
+        collect(indirect(), Operands);
+        return Operands;
     }
 
 protected:
     template <typename T>
-    uint64_t index(std::map<T, uint64_t>& OpTable, const T& Op)
+    uint64_t index(OperandTable<T>& OpTable, const T& Op)
     {
-        auto [Iter, Inserted] = OpTable.try_emplace(Op, Index);
+        auto [I, Inserted] = OpTable.try_emplace(Op, Index);
         if(Inserted)
         {
             Index++;
         }
-        return Iter->second;
+        return I;
+    }
+
+    template <typename T, typename U>
+    static void collect(const std::vector<std::pair<T, uint64_t>>& Entries,
+                        std::vector<U>& Operands)
+    {
+        for(const auto& [Op, I] : Entries)
+        {
+            Operands[I - 1] = Op;
+        }
     }
 
 private:
     // We reserve 0 for empty operators.
     uint64_t Index = 1;
 
-    std::map<relations::ImmOp, uint64_t> Imm;
-    std::map<relations::RegOp, uint64_t> Reg;
-    std::map<relations::IndirectOp, uint64_t> Indirect;
+    OperandTable<relations::ImmOp> Imm;
+    OperandTable<relations::RegOp> Reg;
+    OperandTable<relations::IndirectOp> Indirect;
 };
 
 class InstructionFacts
 {
 public:
+    // Insert facts into the program as they are added instead of storing them.
+    void stream(DatalogProgram& Program)
+    {
+        InstructionSink.emplace(Program, "instruction_complete");
+        InvalidSink.emplace(Program, "invalid_op_code");
+    }
+
     void add(const relations::Instruction& I)
     {
+        if(InstructionSink)
+        {
+            InstructionSink->push(I);
+            return;
+        }
         Instructions.push_back(I);
     }
 
     void invalid(gtirb::Addr A)
     {
+        if(InvalidSink)
+        {
+            InvalidSink->push(A);
+            return;
+        }
         InvalidInstructions.push_back(A);
     }
 
@@ -112,9 +240,59 @@ public:
         return InvalidInstructions;
     }
 
+    // Append the facts of another table, renumbering operand indices with the
+    // given mapping.
+    void merge(InstructionFacts&& Facts, const std::vector<uint64_t>& OpMap)
+    {
+        if(!InstructionSink)
+        {
+            Instructions.reserve(Instructions.size() + Facts.Instructions.size());
+        }
+        for(relations::Instruction& I : Facts.Instructions)
+        {
+            for(uint64_t& OpCode : I.OpCodes)
+            {
+                OpCode = OpMap[OpCode];
+            }
+            add(I);
+        }
+        for(gtirb::Addr A : Facts.InvalidInstructions)
+        {
+            invalid(A);
+        }
+        Facts.Instructions = {};
+        Facts.InvalidInstructions = {};
+    }
+
 private:
     std::vector<relations::Instruction> Instructions;
     std::vector<gtirb::Addr> InvalidInstructions;
+
+    std::optional<RelationSink<relations::Instruction>> InstructionSink;
+    std::optional<RelationSink<gtirb::Addr>> InvalidSink;
+};
+
+// Interned prefix and name of instruction mnemonics, cached by instruction id
+// so that decoding does not build strings for every candidate instruction.
+class MnemonicTable
+{
+public:
+    // If `Prefixed`, the text before the first space of a mnemonic is its
+    // prefix (e.g. "rep stosb").
+    explicit MnemonicTable(bool Prefixed) : Prefixed{Prefixed} {};
+
+    std::tuple<relations::NameId, relations::NameId> get(unsigned int Id, const char* Mnemonic);
+
+private:
+    struct Entry
+    {
+        std::string Mnemonic;
+        relations::NameId Prefix;
+        relations::NameId Name;
+    };
+
+    bool Prefixed;
+    std::vector<std::vector<Entry>> Entries;
 };
 
 template <typename T>
@@ -127,7 +305,14 @@ public:
 
     void operator()(const gtirb::Module& Module, DatalogProgram& Program)
     {
+        Threads = Program.threads();
+        if(const std::optional<std::string>& Directory = Program.decodeCache())
+        {
+            Cache.emplace(*Directory);
+        }
+
         T Facts;
+        Facts.Instructions.stream(Program);
         load(Module, Facts);
         insert(Facts, Program);
     }
@@ -137,6 +322,10 @@ protected:
 
     virtual void insert(const T& Facts, DatalogProgram& Program) = 0;
 
+    // Create an independent decoder (e.g. with its own Capstone handle) for a
+    // worker thread.
+    virtual std::unique_ptr<InstructionLoader> clone() const = 0;
+
     virtual void load(const gtirb::Module& Module, T& Facts)
     {
         for(const auto& Section : Module.sections())
@@ -156,24 +345,98 @@ protected:
     {
         assert(ByteInterval.getAddress() && "ByteInterval is non-addressable.");
 
+        if(!Cache)
+        {
+            decode(ByteInterval, Facts);
+            return;
+        }
+
+        std::string Key = Cache->key(ByteInterval);
+        T Cached;
+        if(!Cache->read(Key, Cached))
+        {
+            decode(ByteInterval, Cached);
+            Cache->write(Key, Cached);
+        }
+        merge(Facts, Cached);
+    }
+
+    // Decode every candidate instruction of a byte interval.
+    void decode(const gtirb::ByteInterval& ByteInterval, T& Facts)
+    {
+
         uint64_t Addr = static_cast<uint64_t>(*ByteInterval.getAddress());
         uint64_t Size = ByteInterval.getInitializedSize();
         auto Data = ByteInterval.rawBytes<const uint8_t>();
 
-        while(Size > 0)
+        uint64_t Shards = std::min<uint64_t>(Threads, Size / MinShardSize);
+        if(Shards <= 1)
         {
-            decode(Facts, Data, Size, Addr);
-            Addr += InstructionSize;
-            Data += InstructionSize;
-            Size -= InstructionSize;
+            decode(Facts, Data, Size, Addr, 0, Size);
+            return;
+        }
+
+        // Split the candidate offsets into contiguous ranges aligned to the
+        // instruction size. Every shard still sees the bytes up to the end of
+        // the interval, so each offset decodes exactly as it would serially.
+        uint64_t Step = Size / Shards + InstructionSize - 1;
+        Step -= Step % InstructionSize;
+
+        std::vector<T> Results(Shards);
+        std::vector<std::unique_ptr<InstructionLoader>> Decoders;
+        for(uint64_t I = 0; I < Shards; I++)
+        {
+            Decoders.push_back(clone());
+        }
+        parallelFor(Shards, Shards, [&](size_t I) {
+            uint64_t Begin = std::min(I * Step, Size);
+            uint64_t End = (I + 1 == Shards) ? Size : std::min(Begin + Step, Size);
+            Decoders[I]->decode(Results[I], Data, Size, Addr, Begin, End);
+        });
+
+        // Merge in address order so operand indices match a serial decode.
+        for(T& Result : Results)
+        {
+            merge(Facts, Result);
         }
     }
 
+    // Decode the candidate instructions starting at offsets [Begin, End).
+    void decode(T& Facts, const uint8_t* Data, uint64_t Size, uint64_t Addr, uint64_t Begin,
+                uint64_t End)
+    {
+        for(uint64_t Offset = Begin; Offset < End; Offset += InstructionSize)
+        {
+            decode(Facts, Data + Offset, Size - Offset, Addr + Offset);
+        }
+    }
+
+    // Append the facts decoded by a shard.
+    virtual void merge(T& Facts, T& Shard)
+    {
+        auto Operands = Shard.Operands.operands();
+        std::vector<uint64_t> OpMap(Operands.size() + 1, 0);
+        for(size_t I = 0; I < Operands.size(); I++)
+        {
+            OpMap[I + 1] = Facts.Operands.add(Operands[I]);
+        }
+        Facts.Instructions.merge(std::move(Shard.Instructions), OpMap);
+    }
+
     // Disassemble bytes and build Instruction and Operand facts.
     virtual void decode(T& Facts, const uint8_t* Bytes, uint64_t Size, uint64_t Addr) = 0;
 
     // We default to decoding instructions at every byte offset.
     uint8_t InstructionSize = 1;
+
+    // Number of worker threads used to decode a byte interval.
+    unsigned int Threads = 1;
+
+    // Smallest byte range worth decoding on a separate thread.
+    uint64_t MinShardSize = 1 << 16;
+
+    // Store of previously decoded byte intervals, if enabled.
+    std::optional<DecodeCache> Cache;
 };
 
 // Decorator for loading instructions from known code blocks.
@@ -0,0 +1,361 @@
+//===- PointerScanner.cpp ---------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#include "PointerScanner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define DDISASM_X86_64
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+PointerScanner::PointerScanner(uint64_t Size, std::vector<Range> R) : PointerSize(Size)
+{
+    // Sort and merge overlapping or adjacent ranges.
+    std::sort(R.begin(), R.end());
+    for(const Range& Next : R)
+    {
+        if(!Ranges.empty() && Next.first <= Ranges.back().second + 1)
+        {
+            Ranges.back().second = std::max(Ranges.back().second, Next.second);
+        }
+        else
+        {
+            Ranges.push_back(Next);
+        }
+    }
+    if(!Ranges.empty())
+    {
+        Min = Ranges.front().first;
+        Span = Ranges.back().second - Min;
+    }
+    Method = best();
+}
+
+PointerScanner::Kernel PointerScanner::best()
+{
+#if defined(DDISASM_X86_64)
+#if defined(_MSC_VER)
+    int Info[4];
+    __cpuidex(Info, 1, 0);
+    bool OSXSave = (Info[2] & (1 << 27)) != 0;
+    bool AVX = (Info[2] & (1 << 28)) != 0;
+    if(OSXSave && AVX && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(Info, 7, 0);
+        if(Info[1] & (1 << 5))
+        {
+            return Kernel::AVX2;
+        }
+    }
+#else
+    if(__builtin_cpu_supports("avx2"))
+    {
+        return Kernel::AVX2;
+    }
+#endif
+    return Kernel::SSE2;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+void PointerScanner::kernel(Kernel K)
+{
+    // Never select a kernel the host cannot run.
+    Method = std::min(K, best());
+}
+
+uint64_t PointerScanner::value(const uint8_t* Data) const
+{
+    if(PointerSize == 4)
+    {
+        int32_t Value;
+        std::memcpy(&Value, Data, sizeof(Value));
+        return static_cast<uint64_t>(static_cast<int64_t>(Value));
+    }
+    uint64_t Value;
+    std::memcpy(&Value, Data, sizeof(Value));
+    return Value;
+}
+
+bool PointerScanner::contains(uint64_t Value) const
+{
+    auto It = std::upper_bound(Ranges.begin(), Ranges.end(), Value,
+                               [](uint64_t V, const Range& R) { return V < R.first; });
+    return It != Ranges.begin() && Value <= std::prev(It)->second;
+}
+
+void PointerScanner::scan(const uint8_t* Data, uint64_t Size,
+                          std::vector<uint64_t>& Offsets) const
+{
+    if(Ranges.empty() || Size < PointerSize)
+    {
+        return;
+    }
+
+    uint64_t Offset = 0;
+    switch(Method)
+    {
+        case Kernel::AVX2:
+            Offset = scanAVX2(Data, Size, Offsets);
+            break;
+        case Kernel::SSE2:
+            Offset = scanSSE2(Data, Size, Offsets);
+            break;
+        case Kernel::Scalar:
+            break;
+    }
+    scanScalar(Data, Offset, Size, Offsets);
+}
+
+void PointerScanner::scanScalar(const uint8_t* Data, uint64_t Begin, uint64_t Size,
+                                std::vector<uint64_t>& Offsets) const
+{
+    for(uint64_t Offset = Begin; Offset + PointerSize <= Size; Offset++)
+    {
+        uint64_t Value = value(Data + Offset);
+        if(Value - Min <= Span && contains(Value))
+        {
+            Offsets.push_back(Offset);
+        }
+    }
+}
+
+#if defined(DDISASM_X86_64)
+
+namespace
+{
+    inline unsigned int lowestBit(uint32_t Bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long Index;
+        _BitScanForward(&Index, Bits);
+        return Index;
+#else
+        return __builtin_ctz(Bits);
+#endif
+    }
+
+    // Unsigned 64-bit `A > B', which SSE2 lacks: compare the high halves and
+    // break ties with the low halves.
+    inline __m128i cmpgtU64(__m128i A, __m128i B)
+    {
+        const __m128i Sign = _mm_set1_epi32(static_cast<int>(0x80000000));
+        A = _mm_xor_si128(A, Sign);
+        B = _mm_xor_si128(B, Sign);
+        __m128i Gt = _mm_cmpgt_epi32(A, B);
+        __m128i Eq = _mm_cmpeq_epi32(A, B);
+        __m128i GtLo = _mm_shuffle_epi32(Gt, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128i GtHi = _mm_shuffle_epi32(Gt, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128i EqHi = _mm_shuffle_epi32(Eq, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_or_si128(GtHi, _mm_and_si128(EqHi, GtLo));
+    }
+} // namespace
+
+// Each kernel builds a bitmap of the offsets of a block whose values are in
+// [Min, Min+Span]. A vector loaded at offset K holds the windows at K, K+W,
+// K+2W, ... for pointers of W bytes, so W loads cover W*Lanes offsets.
+// Hits are then checked against the individual ranges in offset order.
+
+uint64_t PointerScanner::scanSSE2(const uint8_t* Data, uint64_t Size,
+                                  std::vector<uint64_t>& Offsets) const
+{
+    uint64_t Offset = 0;
+    if(PointerSize == 8)
+    {
+        const __m128i VMin = _mm_set1_epi64x(static_cast<int64_t>(Min));
+        const __m128i VSpan = _mm_set1_epi64x(static_cast<int64_t>(Span));
+        for(; Offset + 16 + 8 <= Size; Offset += 16)
+        {
+            uint32_t Masks[8], Any = 0, Bits = 0;
+            for(unsigned int K = 0; K < 8; K++)
+            {
+                __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Offset + K));
+                __m128i Out = cmpgtU64(_mm_sub_epi64(V, VMin), VSpan);
+                Masks[K] = ~_mm_movemask_pd(_mm_castsi128_pd(Out)) & 0x3;
+                Any |= Masks[K];
+            }
+            if(!Any)
+            {
+                continue;
+            }
+            for(unsigned int K = 0; K < 8; K++)
+            {
+                Bits |= ((Masks[K] & 1) << K) | ((Masks[K] >> 1) << (K + 8));
+            }
+            for(; Bits; Bits &= Bits - 1)
+            {
+                uint64_t Hit = Offset + lowestBit(Bits);
+                if(contains(value(Data + Hit)))
+                {
+                    Offsets.push_back(Hit);
+                }
+            }
+        }
+    }
+    else if(Min + Span < 0x80000000)
+    {
+        // Sign extension only matters for values outside the span.
+        const __m128i Sign = _mm_set1_epi32(static_cast<int>(0x80000000));
+        const __m128i VMin = _mm_set1_epi32(static_cast<int>(Min));
+        const __m128i VSpan = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(Span)), Sign);
+        for(; Offset + 16 + 4 <= Size; Offset += 16)
+        {
+            uint32_t Masks[4], Any = 0, Bits = 0;
+            for(unsigned int K = 0; K < 4; K++)
+            {
+                __m128i V = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Offset + K));
+                __m128i D = _mm_xor_si128(_mm_sub_epi32(V, VMin), Sign);
+                __m128i Out = _mm_cmpgt_epi32(D, VSpan);
+                Masks[K] = ~_mm_movemask_ps(_mm_castsi128_ps(Out)) & 0xF;
+                Any |= Masks[K];
+            }
+            if(!Any)
+            {
+                continue;
+            }
+            for(unsigned int K = 0; K < 4; K++)
+            {
+                for(unsigned int J = 0; J < 4; J++)
+                {
+                    Bits |= ((Masks[K] >> J) & 1) << (K + 4 * J);
+                }
+            }
+            for(; Bits; Bits &= Bits - 1)
+            {
+                uint64_t Hit = Offset + lowestBit(Bits);
+                if(contains(value(Data + Hit)))
+                {
+                    Offsets.push_back(Hit);
+                }
+            }
+        }
+    }
+    return Offset;
+}
+
+TARGET_AVX2 uint64_t PointerScanner::scanAVX2(const uint8_t* Data, uint64_t Size,
+                                              std::vector<uint64_t>& Offsets) const
+{
+    uint64_t Offset = 0;
+    if(PointerSize == 8)
+    {
+        const __m256i Sign = _mm256_set1_epi64x(INT64_MIN);
+        const __m256i VMin = _mm256_set1_epi64x(static_cast<int64_t>(Min));
+        const __m256i VSpan = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(Span)), Sign);
+        for(; Offset + 32 + 8 <= Size; Offset += 32)
+        {
+            uint32_t Masks[8], Any = 0, Bits = 0;
+            for(unsigned int K = 0; K < 8; K++)
+            {
+                __m256i V =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data + Offset + K));
+                __m256i D = _mm256_xor_si256(_mm256_sub_epi64(V, VMin), Sign);
+                __m256i Out = _mm256_cmpgt_epi64(D, VSpan);
+                Masks[K] = ~_mm256_movemask_pd(_mm256_castsi256_pd(Out)) & 0xF;
+                Any |= Masks[K];
+            }
+            if(!Any)
+            {
+                continue;
+            }
+            for(unsigned int K = 0; K < 8; K++)
+            {
+                for(unsigned int J = 0; J < 4; J++)
+                {
+                    Bits |= ((Masks[K] >> J) & 1) << (K + 8 * J);
+                }
+            }
+            for(; Bits; Bits &= Bits - 1)
+            {
+                uint64_t Hit = Offset + lowestBit(Bits);
+                if(contains(value(Data + Hit)))
+                {
+                    Offsets.push_back(Hit);
+                }
+            }
+        }
+    }
+    else if(Min + Span < 0x80000000)
+    {
+        const __m256i Sign = _mm256_set1_epi32(static_cast<int>(0x80000000));
+        const __m256i VMin = _mm256_set1_epi32(static_cast<int>(Min));
+        const __m256i VSpan = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(Span)), Sign);
+        for(; Offset + 32 + 4 <= Size; Offset += 32)
+        {
+            uint32_t Masks[4], Any = 0, Bits = 0;
+            for(unsigned int K = 0; K < 4; K++)
+            {
+                __m256i V =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data + Offset + K));
+                __m256i D = _mm256_xor_si256(_mm256_sub_epi32(V, VMin), Sign);
+                __m256i Out = _mm256_cmpgt_epi32(D, VSpan);
+                Masks[K] = ~_mm256_movemask_ps(_mm256_castsi256_ps(Out)) & 0xFF;
+                Any |= Masks[K];
+            }
+            if(!Any)
+            {
+                continue;
+            }
+            for(unsigned int K = 0; K < 4; K++)
+            {
+                for(unsigned int J = 0; J < 8; J++)
+                {
+                    Bits |= ((Masks[K] >> J) & 1) << (K + 4 * J);
+                }
+            }
+            for(; Bits; Bits &= Bits - 1)
+            {
+                uint64_t Hit = Offset + lowestBit(Bits);
+                if(contains(value(Data + Hit)))
+                {
+                    Offsets.push_back(Hit);
+                }
+            }
+        }
+    }
+    return Offset;
+}
+
+#else
+
+uint64_t PointerScanner::scanSSE2(const uint8_t*, uint64_t, std::vector<uint64_t>&) const
+{
+    return 0;
+}
+
+uint64_t PointerScanner::scanAVX2(const uint8_t*, uint64_t, std::vector<uint64_t>&) const
+{
+    return 0;
+}
+
+#endif
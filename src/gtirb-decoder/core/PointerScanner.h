@@ -0,0 +1,86 @@
+//===- PointerScanner.h -----------------------------------------*- C++ -*-===//
+//
+//  Copyright (C) 2020 GrammaTech, Inc.
+//
+//  This code is licensed under the GNU Affero General Public License
+//  as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version. See the
+//  LICENSE.txt file in the project root for license terms or visit
+//  https://www.gnu.org/licenses/agpl.txt.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU Affero General Public License for more details.
+//
+//  This project is sponsored by the Office of Naval Research, One Liberty
+//  Center, 875 N. Randolph Street, Arlington, VA 22203 under contract #
+//  N68335-17-C-0700.  The content of the information does not necessarily
+//  reflect the position or policy of the Government and no official
+//  endorsement should be inferred.
+//
+//===----------------------------------------------------------------------===//
+#ifndef SRC_GTIRB_DECODER_CORE_POINTERSCANNER_H_
+#define SRC_GTIRB_DECODER_CORE_POINTERSCANNER_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Find the offsets of a byte buffer at which a pointer-sized value refers to
+// one of a set of mapped address ranges. Every offset is a candidate, so
+// windows overlap; vectorized kernels test many of them per iteration against
+// the span of all ranges and only the hits are looked up in the ranges.
+class PointerScanner
+{
+public:
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Inclusive range of mapped addresses.
+    using Range = std::pair<uint64_t, uint64_t>;
+
+    PointerScanner() = default;
+
+    // Pointers are little-endian values of `Size' (4 or 8) bytes. Values of
+    // 4 bytes are sign-extended.
+    PointerScanner(uint64_t Size, std::vector<Range> Ranges);
+
+    // Append the offsets of candidate pointers to `Offsets', in order.
+    void scan(const uint8_t* Data, uint64_t Size, std::vector<uint64_t>& Offsets) const;
+
+    // Read the pointer at `Data'.
+    uint64_t value(const uint8_t* Data) const;
+
+    // Whether `Value' is in one of the mapped ranges.
+    bool contains(uint64_t Value) const;
+
+    // The fastest kernel supported by the host.
+    static Kernel best();
+
+    void kernel(Kernel K);
+
+    Kernel kernel() const
+    {
+        return Method;
+    }
+
+private:
+    // Vectorized kernels return the offset at which the scalar scan resumes.
+    void scanScalar(const uint8_t* Data, uint64_t Begin, uint64_t Size,
+                    std::vector<uint64_t>& Offsets) const;
+    uint64_t scanSSE2(const uint8_t* Data, uint64_t Size, std::vector<uint64_t>& Offsets) const;
+    uint64_t scanAVX2(const uint8_t* Data, uint64_t Size, std::vector<uint64_t>& Offsets) const;
+
+    uint64_t PointerSize = 8;
+    std::vector<Range> Ranges;
+    uint64_t Min = 0;
+    uint64_t Span = 0;
+    Kernel Method = Kernel::Scalar;
+};
+
+#endif // SRC_GTIRB_DECODER_CORE_POINTERSCANNER_H_
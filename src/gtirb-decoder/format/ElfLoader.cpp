@@ -27,8 +27,8 @@
 
 void ElfSymbolLoader(const gtirb::Module &Module, DatalogProgram &Program)
 {
-    std::vector<relations::Symbol> Symbols;
-    std::vector<relations::Relocation> Relocations;
+    RelationSink<relations::Symbol> Symbols(Program, "symbol");
+    RelationSink<relations::Relocation> Relocations(Program, "relocation");
 
     // Find extra ELF symbol information in aux data.
     auto *SymbolInfo = Module.getAuxData<gtirb::schema::ElfSymbolInfoAD>();
@@ -56,7 +56,7 @@ void ElfSymbolLoader(const gtirb::Module &Module, DatalogProgram &Program)
         }
 
         auto [Size, Type, Binding, Visibility, SectionIndex] = Info;
-        Symbols.push_back({Addr, Size, Type, Binding, Visibility, SectionIndex, Name});
+        Symbols.push({Addr, Size, Type, Binding, Visibility, SectionIndex, Name});
     }
 
     // Load relocation entries from aux data.
@@ -64,12 +64,9 @@ void ElfSymbolLoader(const gtirb::Module &Module, DatalogProgram &Program)
     {
         for(auto [Address, Type, Name, Addend] : *Table)
         {
-            Relocations.push_back({Address, Type, Name, Addend});
+            Relocations.push({Address, Type, Name, Addend});
         }
     }
-
-    Program.insert("symbol", std::move(Symbols));
-    Program.insert("relocation", std::move(Relocations));
 }
 
 namespace souffle
@@ -33,12 +33,21 @@
 CompositeLoader ElfX64Loader()
 {
     CompositeLoader Loader("souffle_disasm_x64");
-    Loader.add(ModuleLoader);
-    Loader.add(SectionLoader);
-    Loader.add<X64Loader>();
-    Loader.add<DataLoader>(DataLoader::Pointer::QWORD);
-    Loader.add(ElfSymbolLoader);
-    Loader.add(ElfExceptionLoader);
+    // The loaders only read the module and write disjoint relations, so they
+    // run concurrently.
+    Loader.add("ModuleLoader", ModuleLoader,
+               {"binary_isa", "binary_type", "binary_format", "base_address", "entry_point"});
+    Loader.add("SectionLoader", SectionLoader, {"section_complete"});
+    Loader.add("X64Loader", X64Loader{},
+               {"instruction_complete", "invalid_op_code", "op_immediate", "op_regdirect",
+                "op_indirect"});
+    Loader.add("DataLoader", DataLoader{DataLoader::Pointer::QWORD},
+               {"data_byte", "data_fill_range", "address_in_data"});
+    Loader.add("ElfSymbolLoader", ElfSymbolLoader, {"symbol", "relocation"});
+    Loader.add("ElfExceptionLoader", ElfExceptionLoader,
+               {"cie_entry", "cie_encoding", "cie_personality", "fde_entry",
+                "fde_pointer_locations", "fde_instruction", "lsda", "lsda_pointer_locations",
+                "lsda_callsite", "lsda_type_entry"});
     return Loader;
 }
 
@@ -20,9 +20,8 @@
 //  endorsement should be inferred.
 //
 //===----------------------------------------------------------------------===//
-#include <boost/uuid/uuid_generators.hpp>
-
 #include "../AuxDataSchema.h"
+#include "../UUIDGenerator.h"
 #include "../gtirb-decoder/CompositeLoader.h"
 #include "../gtirb-decoder/arch/X64Loader.h"
 #include "../gtirb-decoder/core/AuxDataLoader.h"
@@ -36,7 +35,7 @@ void FunctionInferencePass::updateFunctions(souffle::SouffleProgram* P, gtirb::M
     std::map<gtirb::UUID, std::set<gtirb::UUID>> FunctionEntries;
     std::map<gtirb::Addr, gtirb::UUID> FunctionEntry2function;
     std::map<gtirb::UUID, gtirb::UUID> FunctionNames;
-    boost::uuids::random_generator Generator;
+    UUIDGenerator Generator(M, "function");
     for(auto& Output : *P->getRelation("function_entry_final"))
     {
         gtirb::Addr FunctionEntry(Output[0]);
@@ -44,7 +43,7 @@ void FunctionInferencePass::updateFunctions(souffle::SouffleProgram* P, gtirb::M
         if(!BlockRange.empty())
         {
             const gtirb::UUID& EntryBlockUUID = BlockRange.begin()->getUUID();
-            gtirb::UUID FunctionUUID = Generator();
+            gtirb::UUID FunctionUUID = Generator(FunctionEntry);
             FunctionEntry2function[FunctionEntry] = FunctionUUID;
             FunctionEntries[FunctionUUID].insert(EntryBlockUUID);
             for(const auto& Symbol : M.findSymbols(FunctionEntry))
@@ -78,17 +77,17 @@ void FunctionInferencePass::computeFunctions(gtirb::Context& Context, gtirb::Mod
 {
     // Build GTIRB loader.
     CompositeLoader Loader("souffle_function_inference");
-    Loader.add(BlocksLoader);
+    Loader.add("BlocksLoader", BlocksLoader);
     // TODO: Add support for ARM64 prologues.
     if(Module.getISA() == gtirb::ISA::X64)
     {
         Loader.add<CodeBlockLoader<X64Loader>>();
     }
-    Loader.add(CfgLoader);
-    Loader.add(SymbolicExpressionLoader);
-    Loader.add(FdeEntriesLoader{&Context});
-    Loader.add(FunctionEntriesLoader{&Context});
-    Loader.add(PaddingLoader{&Context});
+    Loader.add("CfgLoader", CfgLoader);
+    Loader.add("SymbolicExpressionLoader", SymbolicExpressionLoader);
+    Loader.add("FdeEntriesLoader", FdeEntriesLoader{&Context});
+    Loader.add("FunctionEntriesLoader", FunctionEntriesLoader{&Context});
+    Loader.add("PaddingLoader", PaddingLoader{&Context});
 
     // Load GTIRB and build program.
     std::optional<DatalogProgram> FunctionInference = Loader.load(Module);
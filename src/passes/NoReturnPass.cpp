@@ -62,8 +62,8 @@ std::set<gtirb::CodeBlock*> NoReturnPass::computeNoReturn(gtirb::Module& Module,
 {
     // Build GTIRB loader.
     CompositeLoader Loader("souffle_no_return");
-    Loader.add(SccLoader);
-    Loader.add(CfgLoader);
+    Loader.add("SccLoader", SccLoader);
+    Loader.add("CfgLoader", CfgLoader);
 
     // Load GTIRB and build program.
     std::optional<DatalogProgram> NoReturn = Loader.load(Module);
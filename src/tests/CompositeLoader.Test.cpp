@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <sstream>
+
 #include <LIEF/LIEF.hpp>
+#include <boost/filesystem.hpp>
 #include <gtirb/gtirb.hpp>
 
 #include "../gtirb-builder/GtirbBuilder.h"
@@ -40,6 +44,19 @@ void TestLoaderFunction(const gtirb::Module& Module, DatalogProgram& Program)
     Program.insert("in_scc", Tuples);
 }
 
+// Check that two relations hold the same tuples, in the same order.
+void expectSameTuples(const souffle::Relation& Relation, const souffle::Relation& Expected)
+{
+    ASSERT_EQ(Relation.size(), Expected.size());
+    for(auto It = Relation.begin(), Jt = Expected.begin(); It != Relation.end(); ++It, ++Jt)
+    {
+        for(size_t I = 0; I < Relation.getArity(); I++)
+        {
+            EXPECT_EQ((*It)[I], (*Jt)[I]);
+        }
+    }
+}
+
 TEST_P(CompositeLoaderTest, build_test_loader)
 {
     // Load GTIRB.
@@ -56,5 +73,109 @@ TEST_P(CompositeLoaderTest, build_test_loader)
     }
 }
 
+TEST_P(CompositeLoaderTest, run_independent_loaders_concurrently)
+{
+    CompositeLoader Loader = CompositeLoader("souffle_no_return");
+    Loader.add("SccLoader", TestLoaderFunction, {"in_scc"});
+    Loader.add(
+        "TopEdgeLoader",
+        [](const gtirb::Module& Module, DatalogProgram& Program) {
+            auto Tuples = {relations::TopEdge{gtirb::Addr(1), "false", "true", "jump"}};
+            Program.insert("cfg_edge_to_top", Tuples);
+        },
+        {"cfg_edge_to_top"});
+    Loader.add("SameSccLoader", TestLoader{}, {"in_scc"});
+
+    std::optional<DatalogProgram> TestProgram = Loader.load(*Module, 4);
+    ASSERT_TRUE(TestProgram);
+    EXPECT_EQ(TestProgram->get()->getRelation("in_scc")->size(), 2);
+    EXPECT_EQ(TestProgram->get()->getRelation("cfg_edge_to_top")->size(), 1);
+}
+
+TEST_P(CompositeLoaderTest, relation_sink_inserts_in_batches)
+{
+    std::optional<DatalogProgram> TestProgram = CompositeLoader("souffle_no_return").load(*Module);
+    ASSERT_TRUE(TestProgram);
+    auto* Relation = TestProgram->get()->getRelation("in_scc");
+    {
+        RelationSink<relations::SccIndex> Sink(*TestProgram, "in_scc", 2);
+        for(uint64_t I = 0; I < 5; I++)
+        {
+            Sink.push({I, static_cast<int64_t>(I), gtirb::Addr(I)});
+        }
+        EXPECT_EQ(Relation->size(), 4);
+    }
+    EXPECT_EQ(Relation->size(), 5);
+}
+
+TEST_P(CompositeLoaderTest, insert_unsorted_tuples)
+{
+    std::optional<DatalogProgram> TestProgram = CompositeLoader("souffle_no_return").program();
+    ASSERT_TRUE(TestProgram);
+    auto Tuples = {relations::SccIndex{3, 3, gtirb::Addr(3)},
+                   relations::SccIndex{1, -1, gtirb::Addr(1)},
+                   relations::SccIndex{2, 2, gtirb::Addr(2)},
+                   relations::SccIndex{1, -1, gtirb::Addr(1)}};
+    TestProgram->insert("in_scc", Tuples);
+
+    auto* Relation = TestProgram->get()->getRelation("in_scc");
+    ASSERT_EQ(Relation->size(), 3);
+    for(const auto& Scc : Tuples)
+    {
+        souffle::tuple Row(Relation);
+        Row << Scc;
+        EXPECT_TRUE(Relation->contains(Row));
+    }
+}
+
+TEST_P(CompositeLoaderTest, write_facts)
+{
+    namespace fs = boost::filesystem;
+    fs::path Directory = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(Directory);
+
+    CompositeLoader Loader = CompositeLoader("souffle_no_return");
+    Loader.add<TestLoader>();
+    Loader.add(TestLoaderFunction);
+    std::optional<DatalogProgram> TestProgram = Loader.load(*Module);
+    ASSERT_TRUE(TestProgram);
+    TestProgram->threads(4);
+    TestProgram->writeFacts(Directory.string() + "/");
+
+    std::ifstream File((Directory / "in_scc.facts").string());
+    std::stringstream Contents;
+    Contents << File.rdbuf();
+    EXPECT_EQ(Contents.str(), "0\t0\t0\n1\t1\t1\n");
+
+    fs::remove_all(Directory);
+}
+
+TEST_P(CompositeLoaderTest, read_facts)
+{
+    namespace fs = boost::filesystem;
+    fs::path Directory = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(Directory / "text");
+    fs::create_directories(Directory / "binary");
+
+    CompositeLoader Loader = CompositeLoader("souffle_no_return");
+    Loader.add<TestLoader>();
+    Loader.add(TestLoaderFunction);
+    std::optional<DatalogProgram> TestProgram = Loader.load(*Module);
+    ASSERT_TRUE(TestProgram);
+    TestProgram->writeFacts((Directory / "text").string() + "/");
+    TestProgram->writeFacts((Directory / "binary").string() + "/", true);
+
+    for(const char* Format : {"text", "binary"})
+    {
+        std::optional<DatalogProgram> Replay = CompositeLoader("souffle_no_return").program();
+        ASSERT_TRUE(Replay);
+        EXPECT_TRUE(Replay->readFacts((Directory / Format).string() + "/"));
+        expectSameTuples(*Replay->get()->getRelation("in_scc"),
+                         *TestProgram->get()->getRelation("in_scc"));
+    }
+
+    fs::remove_all(Directory);
+}
+
 INSTANTIATE_TEST_SUITE_P(GtirbDecoderTests, CompositeLoaderTest,
                          testing::Values("inputs/hello.x64.elf"));
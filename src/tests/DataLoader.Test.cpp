@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include <gtirb/gtirb.hpp>
+
+#include "../gtirb-decoder/CompositeLoader.h"
+#include "../gtirb-decoder/DatalogProgram.h"
+#include "../gtirb-decoder/core/DataLoader.h"
+
+class DataLoaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        IR = gtirb::IR::Create(Ctx);
+        M = IR->addModule(Ctx, "ex");
+    }
+
+    // Load a data section with `Bytes' at 0x1000 into the fill-range test
+    // program (see datalog/data_fill_test.dl).
+    std::optional<DatalogProgram> load(const std::vector<uint8_t>& Bytes)
+    {
+        gtirb::Section* S = M->addSection(Ctx, ".data");
+        S->addFlag(gtirb::SectionFlag::Initialized);
+        S->addByteInterval(Ctx, gtirb::Addr(0x1000), Bytes.begin(), Bytes.end());
+
+        CompositeLoader Loader("souffle_data_fill_test");
+        Loader.add("DataLoader", DataLoader{DataLoader::Pointer::QWORD});
+        return Loader.load(*M);
+    }
+
+    // Value of every byte loaded, either from data_byte or data_fill_range.
+    std::map<uint64_t, uint8_t> loadedBytes(DatalogProgram& Program)
+    {
+        std::map<uint64_t, uint8_t> Loaded;
+        for(souffle::tuple& Row : *Program.get()->getRelation("data_byte"))
+        {
+            EXPECT_TRUE(Loaded.emplace(Row[0], Row[1]).second);
+        }
+        for(souffle::tuple& Row : *Program.get()->getRelation("data_fill_range"))
+        {
+            for(uint64_t EA = Row[0]; EA < static_cast<uint64_t>(Row[1]); EA++)
+            {
+                EXPECT_TRUE(Loaded.emplace(EA, Row[2]).second);
+            }
+        }
+        return Loaded;
+    }
+
+    static bool contains(souffle::Relation* Relation, std::vector<souffle::RamDomain> Values)
+    {
+        souffle::tuple Row(Relation);
+        for(souffle::RamDomain Value : Values)
+        {
+            Row << Value;
+        }
+        return Relation->contains(Row);
+    }
+
+    gtirb::Context Ctx;
+    gtirb::IR* IR;
+    gtirb::Module* M;
+};
+
+TEST_F(DataLoaderTest, fill_ranges)
+{
+    // A long run of 0xCC at 0x1003..0x1100 and a run of 0xAA that is too
+    // short to be a fill range.
+    std::vector<uint8_t> Bytes = {1, 2, 3};
+    Bytes.insert(Bytes.end(), 0x1100 - 0x1003, 0xCC);
+    Bytes.push_back(4);
+    Bytes.insert(Bytes.end(), 80, 0xAA);
+
+    std::optional<DatalogProgram> Program = load(Bytes);
+    ASSERT_TRUE(Program);
+
+    // The aligned interior of the 0xCC run, without its 16-byte margins.
+    auto* Fills = Program->get()->getRelation("data_fill_range");
+    ASSERT_EQ(Fills->size(), 1);
+    EXPECT_TRUE(contains(Fills, {0x1040, 0x10C0, 0xCC}));
+    EXPECT_EQ(Program->get()->getRelation("data_byte")->size(), Bytes.size() - 0x80);
+
+    std::map<uint64_t, uint8_t> Loaded = loadedBytes(*Program);
+    ASSERT_EQ(Loaded.size(), Bytes.size());
+    for(uint64_t I = 0; I < Bytes.size(); I++)
+    {
+        EXPECT_EQ(Loaded[0x1000 + I], Bytes[I]);
+    }
+}
+
+TEST_F(DataLoaderTest, no_fill_range_in_short_runs)
+{
+    // 95 bytes cannot hold a 64-byte aligned block and both margins.
+    std::vector<uint8_t> Bytes(95, 0);
+    Bytes.push_back(1);
+
+    std::optional<DatalogProgram> Program = load(Bytes);
+    ASSERT_TRUE(Program);
+    EXPECT_EQ(Program->get()->getRelation("data_fill_range")->size(), 0);
+    EXPECT_EQ(Program->get()->getRelation("data_byte")->size(), Bytes.size());
+}
+
+TEST_F(DataLoaderTest, fill_blocks_and_words)
+{
+    std::vector<uint8_t> Bytes = {1};
+    Bytes.insert(Bytes.end(), 0x1100 - 0x1001, 0xCC);
+    Bytes.push_back(1);
+    Bytes.insert(Bytes.end(), 0x1200 - 0x1101, 0);
+    Bytes.push_back(1);
+
+    std::optional<DatalogProgram> Program = load(Bytes);
+    ASSERT_TRUE(Program);
+    Program->run();
+
+    auto* Blocks = Program->get()->getRelation("data_fill_block");
+    EXPECT_EQ(Blocks->size(), 4);
+    EXPECT_TRUE(contains(Blocks, {0x1040, 0xCC, 0x10C0}));
+    EXPECT_TRUE(contains(Blocks, {0x1080, 0xCC, 0x10C0}));
+    EXPECT_TRUE(contains(Blocks, {0x1140, 0, 0x11C0}));
+    EXPECT_TRUE(contains(Blocks, {0x1180, 0, 0x11C0}));
+
+    // Same values as data_word for the bytes of the block.
+    auto* Words = Program->get()->getRelation("data_fill_word");
+    EXPECT_FALSE(contains(Words, {0x1040, 2, 0xCCCC}));
+    EXPECT_TRUE(contains(Words, {0x1040, 4, -0x33333334}));
+    EXPECT_TRUE(contains(Words, {0x1040, 8, static_cast<int64_t>(0xCCCCCCCCCCCCCCCC)}));
+    EXPECT_TRUE(contains(Words, {0x1180, 2, 0}));
+    EXPECT_TRUE(contains(Words, {0x1180, 4, 0}));
+    EXPECT_TRUE(contains(Words, {0x1180, 8, 0}));
+}
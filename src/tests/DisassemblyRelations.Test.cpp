@@ -0,0 +1,14 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "../Disassembler.h"
+
+TEST(DisassemblyRelationsTest, retains_function_relations)
+{
+    std::set<std::string> Retained = disassemblyRelations(false, false);
+    EXPECT_EQ(Retained.count("function_inference.function_entry"), 1);
+    EXPECT_EQ(Retained.count("function_inference.in_function"), 1);
+    EXPECT_EQ(Retained.count("best_value_reg"), 0);
+}
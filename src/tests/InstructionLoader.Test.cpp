@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <gtirb/gtirb.hpp>
+
+#include "../gtirb-builder/GtirbBuilder.h"
+#include "../gtirb-decoder/arch/X64Loader.h"
+
+class InstructionLoaderTest : public ::testing::TestWithParam<const char*>
+{
+protected:
+    void SetUp() override
+    {
+        auto GTIRB = GtirbBuilder::read(GetParam());
+        Context = std::move(GTIRB->Context);
+        IR = GTIRB->IR;
+        Module = &*(GTIRB->IR->modules().begin());
+    }
+    std::unique_ptr<gtirb::Context> Context;
+    gtirb::IR* IR;
+    gtirb::Module* Module;
+};
+
+class ShardedX64Loader : public X64Loader
+{
+public:
+    explicit ShardedX64Loader(unsigned int N)
+    {
+        Threads = N;
+        MinShardSize = 16;
+    }
+
+    void cache(const std::string& Directory)
+    {
+        Cache.emplace(Directory);
+    }
+
+    X64Facts facts(const gtirb::Module& Module)
+    {
+        X64Facts Facts;
+        load(Module, Facts);
+        return Facts;
+    }
+};
+
+TEST_P(InstructionLoaderTest, sharded_decode_is_deterministic)
+{
+    X64Facts Serial = ShardedX64Loader(1).facts(*Module);
+    X64Facts Sharded = ShardedX64Loader(7).facts(*Module);
+
+    const auto& Expected = Serial.Instructions.instructions();
+    const auto& Actual = Sharded.Instructions.instructions();
+    ASSERT_EQ(Expected.size(), Actual.size());
+    for(size_t I = 0; I < Expected.size(); I++)
+    {
+        EXPECT_EQ(Expected[I].Addr, Actual[I].Addr);
+        EXPECT_EQ(Expected[I].Size, Actual[I].Size);
+        EXPECT_EQ(Expected[I].Prefix, Actual[I].Prefix);
+        EXPECT_EQ(Expected[I].Name, Actual[I].Name);
+        EXPECT_EQ(Expected[I].OpCodes, Actual[I].OpCodes);
+        EXPECT_EQ(Expected[I].ImmediateOffset, Actual[I].ImmediateOffset);
+        EXPECT_EQ(Expected[I].DisplacementOffset, Actual[I].DisplacementOffset);
+    }
+    EXPECT_EQ(Serial.Instructions.invalid(), Sharded.Instructions.invalid());
+
+    EXPECT_EQ(Serial.Operands.imm(), Sharded.Operands.imm());
+    EXPECT_EQ(Serial.Operands.reg(), Sharded.Operands.reg());
+    EXPECT_EQ(Serial.Operands.indirect(), Sharded.Operands.indirect());
+}
+
+TEST_P(InstructionLoaderTest, cached_decode_is_identical)
+{
+    namespace fs = boost::filesystem;
+    fs::path Directory = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(Directory);
+
+    X64Facts Expected = ShardedX64Loader(1).facts(*Module);
+
+    ShardedX64Loader Loader(1);
+    Loader.cache(Directory.string());
+    X64Facts Miss = Loader.facts(*Module);
+    EXPECT_FALSE(fs::is_empty(Directory));
+    X64Facts Hit = Loader.facts(*Module);
+
+    for(const X64Facts* Facts : {&Miss, &Hit})
+    {
+        const auto& Instructions = Facts->Instructions.instructions();
+        ASSERT_EQ(Expected.Instructions.instructions().size(), Instructions.size());
+        for(size_t I = 0; I < Instructions.size(); I++)
+        {
+            EXPECT_EQ(Expected.Instructions.instructions()[I].Addr, Instructions[I].Addr);
+            EXPECT_EQ(Expected.Instructions.instructions()[I].Name, Instructions[I].Name);
+            EXPECT_EQ(Expected.Instructions.instructions()[I].OpCodes, Instructions[I].OpCodes);
+        }
+        EXPECT_EQ(Expected.Instructions.invalid(), Facts->Instructions.invalid());
+        EXPECT_EQ(Expected.Operands.operands(), Facts->Operands.operands());
+    }
+
+    fs::remove_all(Directory);
+}
+
+INSTANTIATE_TEST_SUITE_P(GtirbDecoderTests, InstructionLoaderTest,
+                         testing::Values("inputs/hello.x64.elf"));
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <gtirb/gtirb.hpp>
+#include "../ModuleIndex.h"
+
+TEST(Unit_ModuleIndex, find_blocks)
+{
+    gtirb::Context Ctx;
+    gtirb::IR* IR = gtirb::IR::Create(Ctx);
+    gtirb::Module* M = IR->addModule(Ctx);
+    gtirb::Section* S = M->addSection(Ctx, "");
+    gtirb::ByteInterval* I = S->addByteInterval(Ctx, gtirb::Addr(0x100), 16);
+
+    gtirb::CodeBlock* B1 = I->addBlock<gtirb::CodeBlock>(Ctx, 0, 4);
+    gtirb::CodeBlock* B2 = I->addBlock<gtirb::CodeBlock>(Ctx, 4, 4);
+    gtirb::DataBlock* D1 = I->addBlock<gtirb::DataBlock>(Ctx, 8, 8);
+    gtirb::DataBlock* D2 = I->addBlock<gtirb::DataBlock>(Ctx, 10, 2);
+
+    ModuleIndex Index(*M);
+    EXPECT_EQ(Index.byteIntervalOn(gtirb::Addr(0x10f)), I);
+    EXPECT_EQ(Index.byteIntervalOn(gtirb::Addr(0x110)), nullptr);
+    EXPECT_EQ(Index.codeBlockOn(gtirb::Addr(0x100)), nullptr);
+
+    Index.indexBlocks();
+    EXPECT_EQ(Index.codeBlockOn(gtirb::Addr(0x103)), B1);
+    EXPECT_EQ(Index.codeBlockOn(gtirb::Addr(0x104)), B2);
+    EXPECT_EQ(Index.codeBlockAt(gtirb::Addr(0x104)), B2);
+    EXPECT_EQ(Index.codeBlockAt(gtirb::Addr(0x105)), nullptr);
+    EXPECT_EQ(Index.codeBlockOn(gtirb::Addr(0x108)), nullptr);
+
+    // Overlapping data blocks are all found, in address order.
+    std::vector<gtirb::DataBlock*> Overlap = {D1, D2};
+    EXPECT_EQ(Index.dataBlocksOn(gtirb::Addr(0x10a)), Overlap);
+    std::vector<gtirb::DataBlock*> Outer = {D1};
+    EXPECT_EQ(Index.dataBlocksOn(gtirb::Addr(0x10c)), Outer);
+}
+
+TEST(Unit_ModuleIndex, find_symbols)
+{
+    gtirb::Context Ctx;
+    gtirb::IR* IR = gtirb::IR::Create(Ctx);
+    gtirb::Module* M = IR->addModule(Ctx);
+    gtirb::Symbol* S1 = M->addSymbol(Ctx, gtirb::Addr(0x100), "a");
+
+    ModuleIndex Index(*M);
+    gtirb::Symbol* S2 = Index.addSymbol(Ctx, gtirb::Addr(0x100), "b");
+    gtirb::Symbol* S3 = Index.addSymbol(Ctx, gtirb::Addr(0x200), "c");
+
+    auto [Begin, End] = Index.symbols(gtirb::Addr(0x100));
+    std::vector<gtirb::Symbol*> Symbols;
+    for(auto It = Begin; It != End; ++It)
+    {
+        Symbols.push_back(It->second);
+    }
+    std::vector<gtirb::Symbol*> Expected = {S1, S2};
+    EXPECT_EQ(Symbols, Expected);
+    EXPECT_EQ(Index.symbols(gtirb::Addr(0x200)).first->second, S3);
+    EXPECT_EQ(S3->getAddress(), gtirb::Addr(0x200));
+}
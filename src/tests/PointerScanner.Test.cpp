@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+#include "../gtirb-decoder/core/PointerScanner.h"
+
+class PointerScannerTest : public ::testing::TestWithParam<uint64_t>
+{
+};
+
+TEST_P(PointerScannerTest, kernels_find_same_pointers)
+{
+    uint64_t Size = GetParam();
+    std::vector<PointerScanner::Range> Ranges = {
+        {0x401000, 0x402000}, {0x404000, 0x404100}, {0x403000, 0x403800}};
+    PointerScanner Scanner(Size, Ranges);
+
+    std::mt19937_64 Random(Size);
+    std::vector<uint8_t> Data(4099);
+    for(uint8_t& Byte : Data)
+    {
+        Byte = Random() % 4 == 0 ? static_cast<uint8_t>(Random()) : 0;
+    }
+    for(int I = 0; I < 200; I++)
+    {
+        // Pointers into mapped ranges and into the gaps between them.
+        uint64_t Value = 0x401000 + Random() % 0x3200;
+        std::memcpy(&Data[Random() % (Data.size() - Size)], &Value, Size);
+    }
+
+    std::vector<uint64_t> Expected;
+    for(uint64_t Offset = 0; Offset + Size <= Data.size(); Offset++)
+    {
+        uint64_t Value = Scanner.value(&Data[Offset]);
+        bool Mapped = false;
+        for(const auto& [Begin, End] : Ranges)
+        {
+            Mapped |= Value >= Begin && Value <= End;
+        }
+        if(Mapped)
+        {
+            Expected.push_back(Offset);
+        }
+    }
+    ASSERT_FALSE(Expected.empty());
+
+    for(auto Kernel : {PointerScanner::Kernel::Scalar, PointerScanner::Kernel::SSE2,
+                       PointerScanner::Kernel::AVX2})
+    {
+        Scanner.kernel(Kernel);
+        std::vector<uint64_t> Offsets;
+        Scanner.scan(Data.data(), Data.size(), Offsets);
+        EXPECT_EQ(Expected, Offsets);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(GtirbDecoderTests, PointerScannerTest, testing::Values(4, 8));
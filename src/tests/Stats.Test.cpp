@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../gtirb-decoder/Stats.h"
+
+TEST(StatsTest, records_enabled_phases)
+{
+    Stats Report;
+    {
+        Stats::Phase Phase = Report.phase("disabled");
+    }
+    Report.enable();
+    Report.value("input_file", "a \"quoted\" name");
+    {
+        Stats::Phase Phase = Report.phase("outer");
+        Stats::Phase Inner = Report.phase("inner");
+        Inner.stop();
+    }
+
+    std::ostringstream Stream;
+    Report.write(Stream);
+    std::string Json = Stream.str();
+    EXPECT_EQ(Json.find("disabled"), std::string::npos);
+    EXPECT_NE(Json.find("\"input_file\": \"a \\\"quoted\\\" name\""), std::string::npos);
+    size_t Inner = Json.find("\"name\": \"inner\"");
+    size_t Outer = Json.find("\"name\": \"outer\"");
+    ASSERT_NE(Inner, std::string::npos);
+    ASSERT_NE(Outer, std::string::npos);
+    // Phases are listed in the order they end.
+    EXPECT_LT(Inner, Outer);
+    EXPECT_NE(Json.find("\"peak_rss_bytes\": "), std::string::npos);
+}
+
+TEST(StatsTest, omits_unmeasured_cpu_time)
+{
+    Stats Report;
+    Report.enable();
+    {
+        Stats::Phase Phase = Report.phase("concurrent", false);
+    }
+
+    std::ostringstream Stream;
+    Report.write(Stream);
+    EXPECT_NE(Stream.str().find("\"cpu_seconds\": null"), std::string::npos);
+}
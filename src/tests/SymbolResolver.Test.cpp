@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+
+#include <gtirb/gtirb.hpp>
+
+#include "../AuxDataSchema.h"
+#include "../ModuleIndex.h"
+#include "../SymbolResolver.h"
+
+class SymbolResolverTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        IR = gtirb::IR::Create(Ctx);
+        M = IR->addModule(Ctx, "ex");
+        M->addAuxData<gtirb::schema::SymbolForwarding>({});
+        M->addAuxData<gtirb::schema::ElfSymbolInfoAD>({});
+    }
+
+    // Symbol of an address as it was looked up before symbols were cached:
+    // the last symbol of the address that is forwarded, or else the first.
+    gtirb::Symbol* lookup(const ModuleIndex& Index, gtirb::Addr A)
+    {
+        const auto* Forwarding = M->getAuxData<gtirb::schema::SymbolForwarding>();
+        auto [Begin, End] = Index.symbols(A);
+        gtirb::Symbol* Best = Begin != End ? Begin->second : nullptr;
+        for(auto It = Begin; It != End; ++It)
+        {
+            if(Forwarding->count(It->second->getUUID()) > 0)
+            {
+                Best = It->second;
+            }
+        }
+        return Best;
+    }
+
+    gtirb::Context Ctx;
+    gtirb::IR* IR;
+    gtirb::Module* M;
+};
+
+TEST_F(SymbolResolverTest, reuse_labels)
+{
+    ModuleIndex Index(*M);
+    SymbolResolver Symbols(Ctx, *M, Index);
+
+    gtirb::Symbol* Label = Symbols.get(gtirb::Addr(0x100));
+    ASSERT_NE(Label, nullptr);
+    EXPECT_EQ(Label->getName(), ".L_100");
+    EXPECT_EQ(Label->getAddress(), gtirb::Addr(0x100));
+    EXPECT_EQ(M->getAuxData<gtirb::schema::ElfSymbolInfoAD>()->count(Label->getUUID()), 1);
+
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x100)), Label);
+    auto Labels = M->findSymbols(".L_100");
+    EXPECT_EQ(std::distance(Labels.begin(), Labels.end()), 1);
+}
+
+TEST_F(SymbolResolverTest, resolve_like_lookup)
+{
+    ModuleIndex Index(*M);
+    gtirb::Symbol* A = Index.addSymbol(Ctx, gtirb::Addr(0x100), "a");
+    gtirb::Symbol* B = Index.addSymbol(Ctx, gtirb::Addr(0x100), "b");
+    gtirb::Symbol* C = Index.addSymbol(Ctx, gtirb::Addr(0x200), "c");
+    Index.addSymbol(Ctx, gtirb::Addr(0x200), "d");
+    gtirb::Symbol* External = M->addSymbol(Ctx, "external");
+    (*M->getAuxData<gtirb::schema::SymbolForwarding>())[B->getUUID()] = External->getUUID();
+    (*M->getAuxData<gtirb::schema::SymbolForwarding>())[A->getUUID()] = External->getUUID();
+
+    SymbolResolver Symbols(Ctx, *M, Index);
+    for(uint64_t Addr : {0x100, 0x200})
+    {
+        EXPECT_EQ(Symbols.get(gtirb::Addr(Addr)), lookup(Index, gtirb::Addr(Addr)));
+    }
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x100)), B);
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x200)), C);
+}
+
+TEST_F(SymbolResolverTest, forward_invalidates_cache)
+{
+    ModuleIndex Index(*M);
+    gtirb::Symbol* A = Index.addSymbol(Ctx, gtirb::Addr(0x100), "a");
+    gtirb::Symbol* B = Index.addSymbol(Ctx, gtirb::Addr(0x100), "b");
+    gtirb::Symbol* C = Index.addSymbol(Ctx, gtirb::Addr(0x200), "c");
+    gtirb::Symbol* External = M->addSymbol(Ctx, "external");
+
+    SymbolResolver Symbols(Ctx, *M, Index);
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x100)), A);
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x200)), C);
+
+    Symbols.forward(*B, *External);
+    EXPECT_EQ(M->getAuxData<gtirb::schema::SymbolForwarding>()->at(B->getUUID()),
+              External->getUUID());
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x100)), B);
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x100)), lookup(Index, gtirb::Addr(0x100)));
+    EXPECT_EQ(Symbols.get(gtirb::Addr(0x200)), C);
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include <gtirb/gtirb.hpp>
+
+#include "../UUIDGenerator.h"
+
+TEST(Unit_UUIDGenerator, deterministic_uuids)
+{
+    gtirb::Context Ctx1, Ctx2;
+    gtirb::Module* M1 = gtirb::IR::Create(Ctx1)->addModule(Ctx1, "ex");
+    gtirb::Module* M2 = gtirb::IR::Create(Ctx2)->addModule(Ctx2, "ex");
+    M1->setISA(gtirb::ISA::X64);
+    M2->setISA(gtirb::ISA::X64);
+
+    // Same module, kind and address in separate runs.
+    UUIDGenerator G1(*M1, "function"), G2(*M2, "function");
+    EXPECT_EQ(G1(gtirb::Addr(0x1000)), G2(gtirb::Addr(0x1000)));
+    EXPECT_NE(G1(gtirb::Addr(0x1000)), G1(gtirb::Addr(0x1001)));
+    // Version 8 UUID of the RFC 4122 variant.
+    EXPECT_EQ(G1(gtirb::Addr(0x1000)).data[6] >> 4, 8);
+    EXPECT_EQ(G1(gtirb::Addr(0x1000)).data[8] >> 6, 2);
+
+    UUIDGenerator Other(*M1, "other");
+    EXPECT_NE(G1(gtirb::Addr(0x1000)), Other(gtirb::Addr(0x1000)));
+
+    M2->setISA(gtirb::ISA::ARM64);
+    UUIDGenerator G3(*M2, "function");
+    EXPECT_NE(G1(gtirb::Addr(0x1000)), G3(gtirb::Addr(0x1000)));
+}
@@ -124,5 +124,85 @@ class AuxDataTests(unittest.TestCase):
             assert found
 
 
+class ThreadsTests(unittest.TestCase):
+    @unittest.skipUnless(
+        platform.system() == "Linux", "This test is linux only."
+    )
+    def test_same_module_with_threads(self):
+        """
+        Test that symbolic expressions and data blocks, which are planned
+        concurrently, are the same with one and with several threads.
+        """
+
+        def summary(ir):
+            m = ir.modules[0]
+            expressions = []
+            for bi in m.byte_intervals:
+                for offset, expr in bi.symbolic_expressions.items():
+                    expressions.append(
+                        (
+                            bi.address + offset,
+                            type(expr).__name__,
+                            tuple(s.name for s in expr.symbols),
+                            getattr(expr, "offset", None),
+                            getattr(expr, "scale", None),
+                            tuple(
+                                sorted(
+                                    str(a)
+                                    for a in getattr(expr, "attributes", ())
+                                )
+                            ),
+                        )
+                    )
+            data_blocks = [(b.address, b.size) for b in m.data_blocks]
+            return sorted(expressions), sorted(data_blocks)
+
+        binary = "ex"
+        with cd(ex_dir / "ex_exceptions1"):
+            self.assertTrue(compile("gcc", "g++", "-O2", []))
+            summaries = []
+            for threads in ["1", "4"]:
+                output = binary + "_j" + threads + ".gtirb"
+                completedProcess = subprocess.run(
+                    ["ddisasm", binary, "--ir", output, "-j", threads]
+                )
+                self.assertEqual(completedProcess.returncode, 0)
+                summaries.append(summary(gtirb.IR.load_protobuf(output)))
+            expressions, data_blocks = summaries[0]
+            self.assertTrue(expressions)
+            self.assertTrue(data_blocks)
+            self.assertEqual(summaries[0], summaries[1])
+
+
+class RetainedRelationsTests(unittest.TestCase):
+    @unittest.skipUnless(
+        platform.system() == "Linux", "This test is linux only."
+    )
+    def test_retained_relations(self):
+        """
+        Test that the relations kept after the Datalog analysis are enough
+        to build GTIRB: the result is the same as with all the relations,
+        which are kept when a debug dir is given.
+        """
+        binary = "ex"
+        with cd(ex_dir / "ex_exceptions1"):
+            self.assertTrue(compile("gcc", "g++", "-O2", []))
+            Path("debug").mkdir(exist_ok=True)
+            outputs = []
+            for output, options in [
+                (binary + "_retained.s", []),
+                (binary + "_all.s", ["--debug-dir", "debug"]),
+            ]:
+                completedProcess = subprocess.run(
+                    ["ddisasm", binary, "--comments", "--asm", output]
+                    + options
+                )
+                self.assertEqual(completedProcess.returncode, 0)
+                with open(output) as f:
+                    outputs.append(f.read())
+            self.assertTrue(outputs[0])
+            self.assertEqual(outputs[0], outputs[1])
+
+
 if __name__ == "__main__":
     unittest.main()